@@ -0,0 +1,154 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+// Times the PNG scanline unfiltering of the stb_image loops against the vectorized kernels
+// Usage: bench [file.png ...] - the files are also fully decoded with and without the kernels
+
+#include "image/PngUnfilter.hpp"
+#include "util/CpuFeatures.hpp"
+
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_ONLY_PNG
+#define STBI_NO_STDIO
+#define STBI_NO_FAILURE_STRINGS
+#include "image/stb_image.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+
+static constexpr uint32_t IMAGE_WIDTH{ 4096 };
+static constexpr uint32_t IMAGE_HEIGHT{ 1024 };
+static constexpr uint32_t REPEATS{ 9 };
+static constexpr const char* FILTER_NAMES[]{ "None", "Sub", "Up", "Avg", "Paeth" };
+
+
+// ====================================================================================================================
+// The stb_image loops for the filters, as in stbi__create_png_image_raw
+static void UnfilterLoop(uint8_t* cur, const uint8_t* prior, const uint8_t* raw, int count, int filter, int bpp)
+{
+	// One loop per filter, with the switch outside of the loops
+	switch (filter) {
+		case 1:
+			for (int k = 0; k < count; ++k) {
+				cur[k] = STBI__BYTECAST(raw[k] + cur[k - bpp]);
+			}
+			break;
+		case 2:
+			for (int k = 0; k < count; ++k) {
+				cur[k] = STBI__BYTECAST(raw[k] + prior[k]);
+			}
+			break;
+		case 3:
+			for (int k = 0; k < count; ++k) {
+				cur[k] = STBI__BYTECAST(raw[k] + ((prior[k] + cur[k - bpp]) >> 1));
+			}
+			break;
+		case 4:
+			for (int k = 0; k < count; ++k) {
+				cur[k] = STBI__BYTECAST(raw[k] + stbi__paeth(cur[k - bpp], prior[k], prior[k - bpp]));
+			}
+			break;
+	}
+}
+
+// ====================================================================================================================
+// The unfiltering hook installed by the library
+static int UnfilterKernels(stbi_uc* cur, const stbi_uc* prior, const stbi_uc* raw, int count, int filter, int bpp)
+{
+	return PngUnfilter::Unfilter(cur, prior, raw, uint32_t(count), uint32_t(filter), uint32_t(bpp)) ? 1 : 0;
+}
+
+// ====================================================================================================================
+// The best time of the repeats, in milliseconds
+template<typename Func>
+static double Time(Func func)
+{
+	double best = 1e9;
+	for (uint32_t ri = 0; ri < REPEATS; ++ri) {
+		const auto start = std::chrono::steady_clock::now();
+		func();
+		const auto end = std::chrono::steady_clock::now();
+		best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+	}
+	return best;
+}
+
+// ====================================================================================================================
+// Unfilters every scanline of the image with the filter, the first scanline is a zeroed prior scanline
+static void UnfilterImage(std::vector<uint8_t>* image, const std::vector<uint8_t>& raw, uint32_t bpp, int filter,
+	bool kernels)
+{
+	const size_t stride = size_t(IMAGE_WIDTH) * bpp;
+	const int count = int(stride - bpp);
+	for (uint32_t ri = 0; ri < IMAGE_HEIGHT; ++ri) {
+		uint8_t* const cur = image->data() + (stride * (ri + 1));
+		const uint8_t* const prior = cur - stride;
+		const uint8_t* const src = raw.data() + (stride * ri);
+		std::memcpy(cur, src, bpp); // The first pixel is handled by stb_image before the loops or kernels
+		if (!kernels || !PngUnfilter::Unfilter(cur + bpp, prior + bpp, src + bpp, uint32_t(count), uint32_t(filter),
+				bpp)) {
+			UnfilterLoop(cur + bpp, prior + bpp, src + bpp, count, filter, int(bpp));
+		}
+	}
+}
+
+// ====================================================================================================================
+int main(int argc, char** argv)
+{
+	bool matched = true;
+	std::printf("Unfiltering a %ux%u image with the %s kernels (ms, best of %u)\n", IMAGE_WIDTH, IMAGE_HEIGHT,
+		CpuFeatures::HasAvx2() ? "AVX2" : "SSE2", REPEATS);
+	for (uint32_t bpp = 3; bpp <= 4; ++bpp) {
+		const size_t stride = size_t(IMAGE_WIDTH) * bpp;
+		std::vector<uint8_t> raw(stride * IMAGE_HEIGHT);
+		for (size_t i = 0; i < raw.size(); ++i) {
+			raw[i] = uint8_t((i * 2654435761u) >> 24);
+		}
+		std::vector<uint8_t> loopImage(stride * (IMAGE_HEIGHT + 1)), kernelImage(stride * (IMAGE_HEIGHT + 1));
+
+		for (int filter = 1; filter <= 4; ++filter) {
+			const double loop = Time([&]() { UnfilterImage(&loopImage, raw, bpp, filter, false); });
+			const double kernel = Time([&]() { UnfilterImage(&kernelImage, raw, bpp, filter, true); });
+			const bool same = (loopImage == kernelImage);
+			matched = matched && same;
+			std::printf("  %u bpp %-5s  loop %7.2f  kernels %7.2f  (%.1fx)%s\n", bpp, FILTER_NAMES[filter], loop,
+				kernel, loop / kernel, same ? "" : "  MISMATCH");
+		}
+	}
+
+	// Full decodes of the given files
+	if (argc > 1) {
+		std::printf("Decoding with stbi_load_from_memory (ms, best of %u)\n", REPEATS);
+	}
+	for (int ai = 1; ai < argc; ++ai) {
+		std::ifstream file(argv[ai], std::ios::binary);
+		const std::vector<uint8_t> data{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+		int x, y, channels;
+		if (!stbi_info_from_memory(data.data(), int(data.size()), &x, &y, &channels)) {
+			std::printf("  %s: not a PNG file\n", argv[ai]);
+			continue;
+		}
+		const auto load = [&data]() {
+			int lx, ly, lc;
+			stbi_image_free(stbi_load_from_memory(data.data(), int(data.size()), &lx, &ly, &lc, 0));
+		};
+		stbi_set_png_unfilter(nullptr);
+		const double loop = Time(load);
+		stbi_set_png_unfilter(UnfilterKernels);
+		const double kernel = Time(load);
+		std::printf("  %s (%dx%d, %d channels)  loop %7.2f  kernels %7.2f  (%.2fx)\n", argv[ai], x, y, channels, loop,
+			kernel, loop / kernel);
+	}
+
+	return matched ? 0 : 1;
+}
@@ -5,6 +5,8 @@
  */
 
 #include "./audio/AudioFile.hpp"
+#include "./audio/AudioPlaylist.hpp"
+#include "./audio/AudioScheduler.hpp"
 
 /// Audio API: Open sound file
 VEGA_API_EXPORT AudioFile* vegaAudioOpenFile(const char* const path, AudioError* error)
@@ -75,3 +77,187 @@ VEGA_API_EXPORT uint64_t vegaAudioReadFrames(AudioFile* handle, uint64_t frameCo
 {
 	return handle ? handle->readFrames(frameCount, buffer) : 0;
 }
+
+/// Audio API: Seek to frame
+VEGA_API_EXPORT VegaBool vegaAudioSeekFrame(AudioFile* handle, uint64_t frame)
+{
+	return (handle && handle->seek(frame)) ? VEGA_TRUE : VEGA_FALSE;
+}
+
+/// Audio API: Build seek index
+VEGA_API_EXPORT VegaBool vegaAudioBuildSeekIndex(AudioFile* handle)
+{
+	return (handle && handle->buildSeekIndex()) ? VEGA_TRUE : VEGA_FALSE;
+}
+
+/// Audio API: Save seek index (null path uses the sidecar file next to the audio file)
+VEGA_API_EXPORT VegaBool vegaAudioSaveSeekIndex(AudioFile* handle, const char* const path)
+{
+	return (handle && handle->saveSeekIndex(path ? path : "")) ? VEGA_TRUE : VEGA_FALSE;
+}
+
+/// Audio API: Load seek index (null path uses the sidecar file next to the audio file)
+VEGA_API_EXPORT VegaBool vegaAudioLoadSeekIndex(AudioFile* handle, const char* const path)
+{
+	return (handle && handle->loadSeekIndex(path ? path : "")) ? VEGA_TRUE : VEGA_FALSE;
+}
+
+/// Audio API: Build seek index in the background
+VEGA_API_EXPORT VegaBool vegaAudioBuildSeekIndexAsync(AudioFile* handle)
+{
+	return (handle && handle->buildSeekIndexAsync()) ? VEGA_TRUE : VEGA_FALSE;
+}
+
+/// Audio API: Clone handle
+VEGA_API_EXPORT AudioFile* vegaAudioCloneHandle(AudioFile* handle, AudioError* error)
+{
+	if (!handle) {
+		*error = AudioError::BAD_STATE_READ;
+		return nullptr;
+	}
+	auto clone = handle->clone();
+	if (!clone) {
+		*error = AudioError::BAD_STATE_READ;
+		return nullptr;
+	}
+	*error = clone->error();
+	if (clone->hasError()) {
+		delete clone;
+		return nullptr;
+	}
+	return clone;
+}
+
+/// Audio API: Get a view of the full PCM data, valid until the handle is destroyed or its residency changes
+VEGA_API_EXPORT VegaBool vegaAudioMapPCM(AudioFile* handle, const int16_t** data, uint64_t* frames)
+{
+	if (!handle) {
+		*data = nullptr;
+		*frames = 0;
+		return VEGA_FALSE;
+	}
+	return handle->mapPCM(data, frames) ? VEGA_TRUE : VEGA_FALSE;
+}
+
+/// Audio API: Get a view of the PCM data with leading and trailing silence removed, valid as for vegaAudioMapPCM
+VEGA_API_EXPORT VegaBool vegaAudioMapTrimmedPCM(AudioFile* handle, uint16_t threshold, const int16_t** data,
+	uint64_t* frames, uint64_t* leadFrames, uint64_t* tailFrames)
+{
+	if (!handle) {
+		*data = nullptr;
+		*frames = *leadFrames = *tailFrames = 0;
+		return VEGA_FALSE;
+	}
+	return handle->mapTrimmedPCM(threshold, data, frames, leadFrames, tailFrames) ? VEGA_TRUE : VEGA_FALSE;
+}
+
+/// Audio API: Make the audio data resident in memory
+VEGA_API_EXPORT VegaBool vegaAudioMakeResident(AudioFile* handle, AudioResidency residency)
+{
+	return (handle && handle->makeResident(residency)) ? VEGA_TRUE : VEGA_FALSE;
+}
+
+/// Audio API: Get the residency and the size of the resident data in bytes
+VEGA_API_EXPORT AudioResidency vegaAudioGetResidency(AudioFile* handle, uint64_t* size)
+{
+	*size = handle ? handle->residentSize() : 0;
+	return handle ? handle->residency() : AudioResidency::STREAM;
+}
+
+/// Audio API: Create stream scheduler (zero workers selects a default for the system)
+VEGA_API_EXPORT AudioScheduler* vegaAudioCreateScheduler(uint32_t workerCount)
+{
+	return new AudioScheduler(workerCount);
+}
+
+/// Audio API: Destroy stream scheduler
+VEGA_API_EXPORT void vegaAudioDestroyScheduler(AudioScheduler* scheduler)
+{
+	if (scheduler) {
+		delete scheduler;
+	}
+}
+
+/// Audio API: Add a stream to the scheduler (the handle must not be used until the stream is removed)
+VEGA_API_EXPORT uint32_t vegaAudioSchedulerAddStream(AudioScheduler* scheduler, AudioFile* handle,
+	uint32_t bufferFrames)
+{
+	return scheduler ? scheduler->addStream(handle, bufferFrames) : 0;
+}
+
+/// Audio API: Remove a stream from the scheduler
+VEGA_API_EXPORT VegaBool vegaAudioSchedulerRemoveStream(AudioScheduler* scheduler, uint32_t stream)
+{
+	return (scheduler && scheduler->removeStream(stream)) ? VEGA_TRUE : VEGA_FALSE;
+}
+
+/// Audio API: Read buffered frames from a scheduled stream
+VEGA_API_EXPORT uint64_t vegaAudioSchedulerReadFrames(AudioScheduler* scheduler, uint32_t stream, uint64_t frameCount,
+	int16_t* buffer)
+{
+	return scheduler ? scheduler->readFrames(stream, frameCount, buffer) : 0;
+}
+
+/// Audio API: Get the buffering status and underrun count of a scheduled stream
+VEGA_API_EXPORT VegaBool vegaAudioSchedulerGetStatus(AudioScheduler* scheduler, uint32_t stream,
+	AudioStreamStatus* status)
+{
+	return (scheduler && scheduler->getStatus(stream, status)) ? VEGA_TRUE : VEGA_FALSE;
+}
+
+/// Audio API: Enable or disable real-time mode (no allocations, locks, or disk waits in reads and seeks)
+VEGA_API_EXPORT VegaBool vegaAudioSetRealtime(AudioFile* handle, VegaBool enabled)
+{
+	return (handle && handle->setRealtime(enabled != VEGA_FALSE)) ? VEGA_TRUE : VEGA_FALSE;
+}
+
+/// Audio API: Probe the info of many files in parallel, without fully opening them
+VEGA_API_EXPORT uint32_t vegaAudioProbeMany(const char* const* paths, uint32_t count, AudioInfo* infos,
+	AudioError* errors)
+{
+	return AudioFile::ProbeMany(paths, count, infos, errors);
+}
+
+/// Audio API: Read frames in reverse
+VEGA_API_EXPORT uint64_t vegaAudioReadFramesReverse(AudioFile* handle, uint64_t frameCount, int16_t* buffer)
+{
+	return handle ? handle->readFramesReverse(frameCount, buffer) : 0;
+}
+
+/// Audio API: Create gapless playlist
+VEGA_API_EXPORT AudioPlaylist* vegaAudioCreatePlaylist(uint32_t sampleRate, uint32_t channels)
+{
+	return ((sampleRate != 0) && (channels != 0)) ? new AudioPlaylist(sampleRate, channels) : nullptr;
+}
+
+/// Audio API: Destroy gapless playlist
+VEGA_API_EXPORT void vegaAudioDestroyPlaylist(AudioPlaylist* playlist)
+{
+	if (playlist) {
+		delete playlist;
+	}
+}
+
+/// Audio API: Append file to playlist
+VEGA_API_EXPORT VegaBool vegaAudioPlaylistAppend(AudioPlaylist* playlist, const char* const path)
+{
+	return (playlist && path && playlist->append(path)) ? VEGA_TRUE : VEGA_FALSE;
+}
+
+/// Audio API: Read frames from playlist
+VEGA_API_EXPORT uint64_t vegaAudioPlaylistReadFrames(AudioPlaylist* playlist, uint64_t frameCount, int16_t* buffer)
+{
+	return playlist ? playlist->readFrames(frameCount, buffer) : 0;
+}
+
+/// Audio API: Playlist error (the last file that failed to open or decode)
+VEGA_API_EXPORT AudioError vegaAudioPlaylistGetError(AudioPlaylist* playlist)
+{
+	return playlist ? playlist->error() : AudioError::NO_ERROR;
+}
+
+/// Audio API: Number of playlist files started
+VEGA_API_EXPORT uint32_t vegaAudioPlaylistGetSegmentCount(AudioPlaylist* playlist)
+{
+	return playlist ? playlist->segmentCount() : 0;
+}
@@ -5,6 +5,7 @@
  */
 
 #include "./image/ImageFile.hpp"
+#include "./image/ImageTicket.hpp"
 
 /// Image API: Open image file
 VEGA_API_EXPORT ImageFile* vegaImageOpenFile(const char* const path, ImageError* error)
@@ -66,4 +67,106 @@ VEGA_API_EXPORT uint32_t vegaImageLoadData(ImageFile* handle, const uint8_t** da
 		return 0;
 	}
 	return 1;
-}
\ No newline at end of file
+}
+
+/// Image API: Open image from memory (the memory is borrowed, and must outlive the handle)
+VEGA_API_EXPORT ImageFile* vegaImageOpenMemory(const uint8_t* data, size_t size, ImageError* error)
+{
+	auto handle = new ImageFile(data, size);
+	*error = handle->error();
+	if (handle->hasError()) {
+		delete handle;
+		return nullptr;
+	}
+	return handle;
+}
+
+/// Image API: Decode image into caller memory
+VEGA_API_EXPORT VegaBool vegaImageDecodeInto(ImageFile* handle, ImageChannels channels, void* dst, size_t rowPitch)
+{
+	return (handle && handle->decodeInto(channels, dst, rowPitch)) ? VEGA_TRUE : VEGA_FALSE;
+}
+
+/// Image API: Open and load many images in parallel (successful results must be closed with vegaImageCloseFile)
+VEGA_API_EXPORT uint32_t vegaImageLoadBatch(const char* const* paths, uint32_t count, ImageChannels channels,
+	ImageLoadResult* results)
+{
+	return ImageFile::LoadMany(paths, count, channels, results);
+}
+
+/// Image API: Load image data on the shared thread pool (the handle must not be used until the load is finished)
+VEGA_API_EXPORT ImageTicket* vegaImageLoadAsync(ImageFile* handle, ImageChannels channels, ImageLoadCallback callback,
+	void* userData)
+{
+	return handle ? new ImageTicket(handle, channels, callback, userData) : nullptr;
+}
+
+/// Image API: Async load status
+VEGA_API_EXPORT ImageTicketStatus vegaImageTicketStatus(ImageTicket* ticket)
+{
+	return ticket ? ticket->status() : ImageTicketStatus::FAILED;
+}
+
+/// Image API: Wait for async load
+VEGA_API_EXPORT ImageTicketStatus vegaImageTicketWait(ImageTicket* ticket)
+{
+	return ticket ? ticket->wait() : ImageTicketStatus::FAILED;
+}
+
+/// Image API: Release async load ticket (waits for the load to finish)
+VEGA_API_EXPORT void vegaImageTicketRelease(ImageTicket* ticket)
+{
+	if (ticket) {
+		delete ticket;
+	}
+}
+
+/// Image API: Generate the mipmap chain (null options uses the box filter, the chain is owned by the handle)
+VEGA_API_EXPORT VegaBool vegaImageGenerateMips(ImageFile* handle, ImageChannels channels,
+	const ImageMipOptions* options, ImageMipChain* chain)
+{
+	static const ImageMipOptions DEFAULT_OPTIONS{ ImageMipFilter::BOX, VEGA_FALSE, 0.0f };
+	if (!handle || !chain) {
+		return VEGA_FALSE;
+	}
+	return handle->generateMips(channels, options ? *options : DEFAULT_OPTIONS, chain) ? VEGA_TRUE : VEGA_FALSE;
+}
+
+/// Image API: Compress the image into texture data (the texture data is owned by the handle)
+VEGA_API_EXPORT VegaBool vegaImageCompress(ImageFile* handle, const ImageCompressOptions* options, ImageMipChain* chain)
+{
+	if (!handle || !options || !chain) {
+		return VEGA_FALSE;
+	}
+	return handle->compress(*options, chain) ? VEGA_TRUE : VEGA_FALSE;
+}
+
+/// Image API: Compress the image into texture data, using and adding entries in a cache directory (which must exist)
+VEGA_API_EXPORT VegaBool vegaImageCompressCached(ImageFile* handle, const ImageCompressOptions* options,
+	const char* cacheDir, ImageMipChain* chain)
+{
+	if (!handle || !options || !cacheDir || !chain) {
+		return VEGA_FALSE;
+	}
+	return handle->compressCached(*options, cacheDir, chain) ? VEGA_TRUE : VEGA_FALSE;
+}
+
+/// Image API: Texture file data info (false for image files that are not texture files)
+VEGA_API_EXPORT VegaBool vegaImageGetTextureInfo(ImageFile* handle, ImageTextureInfo* info)
+{
+	if (!handle || !info || !handle->textureLevels().data) {
+		return VEGA_FALSE;
+	}
+	*info = handle->textureInfo();
+	return VEGA_TRUE;
+}
+
+/// Image API: Texture file data levels (the levels point into the file data, and stay valid until the handle is closed)
+VEGA_API_EXPORT VegaBool vegaImageGetTextureLevels(ImageFile* handle, ImageMipChain* chain)
+{
+	if (!handle || !chain || !handle->textureLevels().data) {
+		return VEGA_FALSE;
+	}
+	*chain = handle->textureLevels();
+	return VEGA_TRUE;
+}
@@ -4,21 +4,55 @@
  * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
  */
 
+#include "../util/Realtime.hpp"
+#if defined(VEGA_REALTIME_CHECKS)
+#	define DRWAV_MALLOC(sz) RealtimeSection::Malloc(sz)
+#	define DRWAV_REALLOC(p, sz) RealtimeSection::Realloc((p), (sz))
+#	define DRWAV_FREE(p) RealtimeSection::Free(p)
+#	define DRFLAC_MALLOC(sz) RealtimeSection::Malloc(sz)
+#	define DRFLAC_REALLOC(p, sz) RealtimeSection::Realloc((p), (sz))
+#	define DRFLAC_FREE(p) RealtimeSection::Free(p)
+#endif
+
 #define DR_WAV_IMPLEMENTATION
 #define DR_FLAC_IMPLEMENTATION
 #include "./AudioFile.hpp"
+#include "./PCMScan.hpp"
+#include "./ImaAdpcm.hpp"
+#include "../util/ThreadPool.hpp"
 
-#include <fstream>
 #include <algorithm>
+#include <cstring>
+#include <fstream>
 
 
 // ====================================================================================================================
 AudioFile::AudioFile(const std::string& path)
 	: path_{ path }
 	, type_{ DetectType(path) }
+	, file_{ }
+	, vorbisSetup_{ }
 	, handle_{ nullptr }
 	, info_{ }
+	, remaining_{ 0 }
 	, lastError_{ AudioError::NO_ERROR }
+	, seekIndex_{ }
+	, vorbisPages_{ }
+	, flacSeekpoints_{ }
+	, indexThread_{ }
+	, indexReady_{ false }
+	, pendingIndex_{ }
+	, decodedPCM_{ }
+	, pcmDecoded_{ false }
+	, trimmedPCM_{ }
+	, resident_{ }
+	, blockCache_{ }
+	, cachedBlock_{ NO_BLOCK }
+	, realtime_{ false }
+	, reverseBlock_{ }
+	, reverseStart_{ 0 }
+	, reverseFrames_{ 0 }
+	, needsSeek_{ false }
 {
 	// Unknown type cut out early
 	if (type_ == AudioType::UNKNOWN) {
@@ -26,19 +60,22 @@ AudioFile::AudioFile(const std::string& path)
 		return;
 	}
 
-	// Try to open file
+	// Try to map file
 	{
-		std::ifstream file(path);
-		if (!file.is_open()) {
+		std::shared_ptr<const MappedFile> file{ new MappedFile(path) };
+		if (!file->isOpen()) {
 			lastError_ = AudioError::FILE_NOT_FOUND;
 			return;
 		}
+		file_ = file;
 	}
 
 	// Initialize the file handle
+	const auto data = file_->data();
+	const auto size = file_->size();
 	if (type_ == AudioType::WAV) {
 		handle_.wav = new drwav;
-		if (!drwav_init_file(handle_.wav, path.c_str(), nullptr)) {
+		if (!drwav_init_memory(handle_.wav, data, size_t(size), nullptr)) {
 			delete handle_.wav;
 			handle_.wav = nullptr;
 			lastError_ = AudioError::INVALID_FILE;
@@ -46,13 +83,16 @@ AudioFile::AudioFile(const std::string& path)
 	}
 	else if (type_ == AudioType::VORBIS) {
 		int err;
-		handle_.vorbis = stb_vorbis_open_filename(path.c_str(), &err, nullptr);
+		handle_.vorbis = (size <= INT32_MAX) ? stb_vorbis_open_memory(data, int(size), &err, nullptr) : nullptr;
 		if (!handle_.vorbis) {
 			lastError_ = AudioError::INVALID_FILE;
 		}
+		else {
+			vorbisSetup_.reset(handle_.vorbis, stb_vorbis_close);
+		}
 	}
 	else if (type_ == AudioType::FLAC) {
-		handle_.flac = drflac_open_file(path.c_str(), nullptr);
+		handle_.flac = drflac_open_memory(data, size_t(size), nullptr);
 		if (!handle_.flac) {
 			lastError_ = AudioError::INVALID_FILE;
 		}
@@ -82,24 +122,113 @@ AudioFile::AudioFile(const std::string& path)
 	remaining_ = info_.totalFrames;
 }
 
+// ====================================================================================================================
+AudioFile::AudioFile(const AudioFile* source)
+	: path_{ source->path_ }
+	, type_{ source->type_ }
+	, file_{ source->file_ }
+	, vorbisSetup_{ source->vorbisSetup_ }
+	, handle_{ nullptr }
+	, info_{ source->info_ }
+	, remaining_{ source->info_.totalFrames }
+	, lastError_{ AudioError::NO_ERROR }
+	, seekIndex_{ source->seekIndex_ }
+	, vorbisPages_{ }
+	, flacSeekpoints_{ }
+	, indexThread_{ }
+	, indexReady_{ false }
+	, pendingIndex_{ }
+	, decodedPCM_{ }
+	, pcmDecoded_{ false }
+	, trimmedPCM_{ }
+	, resident_{ source->resident_ }
+	, blockCache_{ }
+	, cachedBlock_{ NO_BLOCK }
+	, realtime_{ false }
+	, reverseBlock_{ }
+	, reverseStart_{ 0 }
+	, reverseFrames_{ 0 }
+	, needsSeek_{ false }
+{
+	// Initialize a new decoder on the shared file contents
+	const auto data = file_->data();
+	const auto size = file_->size();
+	if (type_ == AudioType::WAV) {
+		handle_.wav = new drwav;
+		if (!drwav_init_memory(handle_.wav, data, size_t(size), nullptr)) {
+			delete handle_.wav;
+			handle_.wav = nullptr;
+			lastError_ = AudioError::INVALID_FILE;
+		}
+	}
+	else if (type_ == AudioType::VORBIS) {
+		// Fall back to a full decoder (with its own setup) for streams that cannot share
+		int err;
+		handle_.vorbis = stb_vorbis_open_shared(vorbisSetup_.get(), &err, nullptr);
+		if (!handle_.vorbis) {
+			handle_.vorbis = stb_vorbis_open_memory(data, int(size), &err, nullptr);
+			if (handle_.vorbis) {
+				vorbisSetup_.reset(handle_.vorbis, stb_vorbis_close);
+			}
+		}
+		if (!handle_.vorbis) {
+			lastError_ = AudioError::INVALID_FILE;
+		}
+	}
+	else if (type_ == AudioType::FLAC) {
+		handle_.flac = drflac_open_memory(data, size_t(size), nullptr);
+		if (!handle_.flac) {
+			lastError_ = AudioError::INVALID_FILE;
+		}
+	}
+	if (lastError_ != AudioError::NO_ERROR) {
+		return;
+	}
+
+	if (hasSeekIndex()) {
+		applySeekIndex();
+	}
+}
+
 // ====================================================================================================================
 AudioFile::~AudioFile()
 {
+	if (indexThread_.joinable()) {
+		indexThread_.join();
+	}
+
 	if (type_ == AudioType::WAV && handle_.wav) {
 		drwav_uninit(handle_.wav);
 		delete handle_.wav;
 	}
 	else if (type_ == AudioType::VORBIS && handle_.vorbis) {
-		stb_vorbis_close(handle_.vorbis);
+		// The decoder that owns the shared setup is released with the last reference to it
+		if (handle_.vorbis != vorbisSetup_.get()) {
+			stb_vorbis_close(handle_.vorbis);
+		}
+		vorbisSetup_.reset();
 	}
 	else if (type_ == AudioType::FLAC && handle_.flac) {
 		drflac_close(handle_.flac);
 	}
 }
 
+// ====================================================================================================================
+AudioFile* AudioFile::clone() const
+{
+	// Any handle with an open decoder can be cloned, even if the last read failed
+	const bool open =
+		(type_ == AudioType::WAV) ? !!handle_.wav :
+		(type_ == AudioType::VORBIS) ? !!handle_.vorbis :
+		(type_ == AudioType::FLAC) ? !!handle_.flac : false;
+	return open ? new AudioFile(this) : nullptr;
+}
+
 // ====================================================================================================================
 uint64_t AudioFile::readFrames(uint64_t frameCount, int16_t* buffer)
 {
+	const RealtimeSection section{ realtime_ };
+
 	// Check error states
 	if (lastError_ != AudioError::NO_ERROR) {
 		lastError_ = AudioError::BAD_STATE_READ;
@@ -109,6 +238,9 @@ uint64_t AudioFile::readFrames(uint64_t frameCount, int16_t* buffer)
 		lastError_ = AudioError::READ_AT_END;
 		return 0;
 	}
+	if (needsSeek_ && !seek(info_.totalFrames - remaining_)) {
+		return 0;
+	}
 
 	// Get actual read size
 	const uint64_t fCount = std::min(frameCount, remaining_);
@@ -116,7 +248,10 @@ uint64_t AudioFile::readFrames(uint64_t frameCount, int16_t* buffer)
 
 	// Dispatch read command
 	uint64_t actual = 0;
-	if (type_ == AudioType::WAV) {
+	if (resident_) {
+		actual = readResident(fCount, buffer);
+	}
+	else if (type_ == AudioType::WAV) {
 		actual = drwav_read_pcm_frames_s16(handle_.wav, fCount, buffer);
 	}
 	else if (type_ == AudioType::VORBIS) {
@@ -138,6 +273,562 @@ uint64_t AudioFile::readFrames(uint64_t frameCount, int16_t* buffer)
 	}
 }
 
+// ====================================================================================================================
+bool AudioFile::seek(uint64_t frame)
+{
+	const RealtimeSection section{ realtime_ };
+
+	// Check error states, reaching the end of the file is recoverable by seeking
+	if ((lastError_ != AudioError::NO_ERROR) && (lastError_ != AudioError::READ_AT_END)) {
+		return false;
+	}
+	if (frame > info_.totalFrames) {
+		return false;
+	}
+
+	// Dispatch seek command
+	bool success = true;
+	if (frame == info_.totalFrames) {
+		// Nothing to decode, the next read will report the end of the file
+	}
+	else if (resident_) {
+		// Resident data is read directly at the position
+	}
+	else if (type_ == AudioType::WAV) {
+		success = drwav_seek_to_pcm_frame(handle_.wav, frame);
+	}
+	else if (type_ == AudioType::VORBIS) {
+		if (!realtime_ && !hasSeekIndex() && !collectSeekIndex(false)) {
+			buildSeekIndex(); // Failure falls back to page probing in the decoder
+		}
+		success = stb_vorbis_seek(handle_.vorbis, uint32_t(frame));
+	}
+	else {
+		if (!realtime_) {
+			collectSeekIndex(false);
+		}
+		success = drflac_seek_to_pcm_frame(handle_.flac, frame);
+	}
+
+	// Report
+	if (!success) {
+		lastError_ = AudioError::BAD_SEEK;
+		return false;
+	}
+	else {
+		lastError_ = AudioError::NO_ERROR;
+		remaining_ = info_.totalFrames - frame;
+		needsSeek_ = false;
+		return true;
+	}
+}
+
+// ====================================================================================================================
+uint64_t AudioFile::readFramesReverse(uint64_t frameCount, int16_t* buffer)
+{
+	// Check error states
+	if ((lastError_ != AudioError::NO_ERROR) && (lastError_ != AudioError::READ_AT_END)) {
+		lastError_ = AudioError::BAD_STATE_READ;
+		return 0;
+	}
+	uint64_t position = info_.totalFrames - remaining_;
+	if (position == 0) {
+		lastError_ = AudioError::READ_AT_END;
+		return 0;
+	}
+
+	const uint64_t fCount = std::min(frameCount, position);
+	const uint32_t channels = info_.channels;
+	uint64_t count = 0;
+	while (count < fCount) {
+		// Decode the aligned block holding the frame before the position, up to the position
+		const uint64_t frame = position - 1;
+		if ((frame < reverseStart_) || (frame >= (reverseStart_ + reverseFrames_))) {
+			const uint64_t start = (frame / REVERSE_BLOCK_FRAMES) * REVERSE_BLOCK_FRAMES;
+			const uint64_t length = position - start;
+			reverseBlock_.resize(size_t(REVERSE_BLOCK_FRAMES * channels));
+			reverseFrames_ = 0;
+			if (!seek(start) || (readFrames(length, reverseBlock_.data()) != length)) {
+				return 0;
+			}
+			reverseStart_ = start;
+			reverseFrames_ = length;
+		}
+
+		// Emit the block frames in reverse
+		const uint64_t length = std::min(frame + 1 - reverseStart_, fCount - count);
+		const int16_t* src = reverseBlock_.data() + ((frame - reverseStart_) * channels);
+		int16_t* dst = buffer + (count * channels);
+		for (uint64_t i = 0; i < length; ++i, src -= channels, dst += channels) {
+			std::memcpy(dst, src, channels * sizeof(int16_t));
+		}
+		count += length;
+		position -= length;
+	}
+
+	// The decoder is moved to the new position by the next forward read
+	lastError_ = AudioError::NO_ERROR;
+	remaining_ = info_.totalFrames - position;
+	needsSeek_ = true;
+	return count;
+}
+
+// ====================================================================================================================
+bool AudioFile::mapPCM(const int16_t** data, uint64_t* frames)
+{
+	*data = nullptr;
+	*frames = 0;
+	if (!file_ || ((lastError_ != AudioError::NO_ERROR) && (lastError_ != AudioError::READ_AT_END))) {
+		return false;
+	}
+
+	// Use the file data directly when possible
+	if (const auto direct = findDirectPCM()) {
+		*data = direct;
+		*frames = info_.totalFrames;
+		return true;
+	}
+
+	// Decode the full file
+	if (!pcmDecoded_) {
+		uint64_t lead;
+		if (!decodePCM(NO_TRIM, &decodedPCM_, &lead)) {
+			return false;
+		}
+		pcmDecoded_ = true;
+	}
+	*data = decodedPCM_.data();
+	*frames = info_.totalFrames;
+	return true;
+}
+
+// ====================================================================================================================
+bool AudioFile::mapTrimmedPCM(uint16_t threshold, const int16_t** data, uint64_t* frames, uint64_t* leadFrames,
+	uint64_t* tailFrames)
+{
+	*data = nullptr;
+	*frames = *leadFrames = *tailFrames = 0;
+	if (!file_ || ((lastError_ != AudioError::NO_ERROR) && (lastError_ != AudioError::READ_AT_END))) {
+		return false;
+	}
+	const uint32_t channels = info_.channels;
+
+	// Trimming the file data directly only offsets the view
+	if (const auto direct = findDirectPCM()) {
+		const size_t count = size_t(info_.totalFrames * channels);
+		const uint64_t first = PCMScan::FindFirstAbove(direct, count, threshold) / channels;
+		const uint64_t end = (first == info_.totalFrames)
+			? first
+			: ((PCMScan::FindEndAbove(direct, count, threshold) + channels - 1) / channels);
+		*data = direct + (first * channels);
+		*frames = end - first;
+		*leadFrames = first;
+		*tailFrames = info_.totalFrames - end;
+		return true;
+	}
+
+	// Decode the trimmed file, or reuse an earlier decode with the same threshold
+	auto trimmed = std::find_if(trimmedPCM_.begin(), trimmedPCM_.end(),
+		[threshold](const TrimmedPCM& decoded) { return decoded.threshold == threshold; });
+	if (trimmed == trimmedPCM_.end()) {
+		TrimmedPCM decoded{ threshold, 0, { } };
+		if (!decodePCM(int32_t(threshold), &decoded.pcm, &decoded.leadFrames)) {
+			return false;
+		}
+		// Moving the decodes as the list grows keeps their data in place, so earlier views stay valid
+		trimmedPCM_.push_back(std::move(decoded));
+		trimmed = trimmedPCM_.end() - 1;
+	}
+	const uint64_t decodedFrames = trimmed->pcm.size() / channels;
+	*data = trimmed->pcm.data();
+	*frames = decodedFrames;
+	*leadFrames = trimmed->leadFrames;
+	*tailFrames = info_.totalFrames - trimmed->leadFrames - decodedFrames;
+	return true;
+}
+
+// ====================================================================================================================
+bool AudioFile::decodePCM(int32_t threshold, std::vector<int16_t>* output, uint64_t* leadFrames) const
+{
+	// Decode with a clone, to keep the read position of this handle
+	std::unique_ptr<AudioFile> decoder{ clone() };
+	if (!decoder || decoder->hasError()) {
+		return false;
+	}
+	const uint32_t channels = info_.channels;
+	std::vector<int16_t> pcm{ };
+	uint64_t lead = 0;
+	if (threshold == NO_TRIM) {
+		pcm.resize(size_t(info_.totalFrames * channels));
+		if (decoder->readFrames(info_.totalFrames, pcm.data()) != info_.totalFrames) {
+			return false;
+		}
+	}
+	else {
+		// Leading silence is decoded in chunks and dropped, and only the rest of the file is kept
+		static constexpr uint64_t CHUNK_FRAMES{ 4096 };
+		std::vector<int16_t> chunk(size_t(CHUNK_FRAMES * channels));
+		bool found = false;
+		while (!found && (decoder->remaining() > 0)) {
+			const uint64_t count = decoder->readFrames(std::min(CHUNK_FRAMES, decoder->remaining()), chunk.data());
+			if (count == 0) {
+				return false;
+			}
+			const uint64_t first =
+				PCMScan::FindFirstAbove(chunk.data(), size_t(count * channels), uint16_t(threshold)) / channels;
+			if (first < count) {
+				found = true;
+				pcm.reserve(size_t((count - first + decoder->remaining()) * channels));
+				pcm.assign(chunk.begin() + size_t(first * channels), chunk.begin() + size_t(count * channels));
+			}
+			lead += first;
+		}
+		if (found && (decoder->remaining() > 0)) {
+			const size_t offset = pcm.size();
+			const uint64_t rest = decoder->remaining();
+			pcm.resize(offset + size_t(rest * channels));
+			if (decoder->readFrames(rest, pcm.data() + offset) != rest) {
+				return false;
+			}
+		}
+
+		// Remove trailing silence, and shrink to fit
+		const size_t end = PCMScan::FindEndAbove(pcm.data(), pcm.size(), uint16_t(threshold));
+		pcm.resize(((end + channels - 1) / channels) * channels);
+		pcm.shrink_to_fit();
+	}
+	output->swap(pcm);
+	*leadFrames = lead;
+	return true;
+}
+
+// ====================================================================================================================
+const int16_t* AudioFile::findDirectPCM() const
+{
+	if (resident_ && (resident_->residency == AudioResidency::PCM)) {
+		return resident_->pcm;
+	}
+	if (type_ != AudioType::WAV) {
+		return nullptr;
+	}
+
+	// Must be aligned little-endian 16-bit PCM that is entirely inside of the file
+	const auto wav = handle_.wav;
+	if ((wav->translatedFormatTag != DR_WAVE_FORMAT_PCM) || (wav->bitsPerSample != 16) ||
+			(wav->fmt.blockAlign != (2 * wav->channels)) || ((wav->dataChunkDataPos % alignof(int16_t)) != 0)) {
+		return nullptr;
+	}
+	const uint64_t size = info_.totalFrames * wav->fmt.blockAlign;
+	if ((wav->dataChunkDataPos + size) > file_->size()) {
+		return nullptr;
+	}
+	return reinterpret_cast<const int16_t*>(file_->data() + wav->dataChunkDataPos);
+}
+
+// ====================================================================================================================
+const uint8_t* AudioFile::findDirectAdpcm() const
+{
+	if (type_ != AudioType::WAV) {
+		return nullptr;
+	}
+
+	// Must be IMA ADPCM with complete blocks for all frames that are entirely inside of the file
+	const auto wav = handle_.wav;
+	const uint32_t channels = wav->channels;
+	if ((wav->translatedFormatTag != DR_WAVE_FORMAT_DVI_ADPCM) ||
+			!ImaAdpcm::IsValidBlockAlign(wav->fmt.blockAlign, channels)) {
+		return nullptr;
+	}
+	const uint32_t blockFrames = ImaAdpcm::FramesPerBlock(wav->fmt.blockAlign, channels);
+	const uint64_t size = ((info_.totalFrames + blockFrames - 1) / blockFrames) * wav->fmt.blockAlign;
+	if ((size > wav->dataChunkDataSize) || ((wav->dataChunkDataPos + size) > file_->size())) {
+		return nullptr;
+	}
+	return file_->data() + wav->dataChunkDataPos;
+}
+
+// ====================================================================================================================
+bool AudioFile::makeResident(AudioResidency residency)
+{
+	if (!file_ || ((lastError_ != AudioError::NO_ERROR) && (lastError_ != AudioError::READ_AT_END))) {
+		return false;
+	}
+	if (residency == this->residency()) {
+		return true;
+	}
+	const uint64_t position = info_.totalFrames - remaining_;
+	const uint32_t channels = info_.channels;
+
+	// Return to streaming by moving the decoder to the current position
+	if (residency == AudioResidency::STREAM) {
+		resident_.reset();
+		std::vector<int16_t>{ }.swap(blockCache_);
+		cachedBlock_ = NO_BLOCK;
+		return seek(position);
+	}
+
+	std::shared_ptr<Resident> resident{ new Resident{ } };
+	resident->residency = residency;
+	if (residency == AudioResidency::PCM) {
+		if (const auto direct = findDirectPCM()) {
+			resident->pcm = direct;
+		}
+		else {
+			// An existing full decode is moved, which keeps its data (and any views of it) in place
+			if (pcmDecoded_) {
+				resident->ownedPCM.swap(decodedPCM_);
+				pcmDecoded_ = false;
+			}
+			else {
+				uint64_t lead;
+				if (!decodePCM(NO_TRIM, &resident->ownedPCM, &lead)) {
+					return false;
+				}
+			}
+			resident->pcm = resident->ownedPCM.data();
+		}
+		resident->size = info_.totalFrames * channels * sizeof(int16_t);
+	}
+	else if (residency == AudioResidency::IMA_ADPCM) {
+		if (const auto direct = findDirectAdpcm()) {
+			resident->blocks = direct;
+			resident->blockAlign = handle_.wav->fmt.blockAlign;
+		}
+		else {
+			// Encode from the full PCM, using a temporary decode if it was not already decoded for a view
+			std::vector<int16_t> decoded{ };
+			const int16_t* pcm = findDirectPCM();
+			if (!pcm && pcmDecoded_) {
+				pcm = decodedPCM_.data();
+			}
+			else if (!pcm) {
+				uint64_t lead;
+				if (!decodePCM(NO_TRIM, &decoded, &lead)) {
+					return false;
+				}
+				pcm = decoded.data();
+			}
+			ImaAdpcm::Encode(pcm, info_.totalFrames, channels, &resident->ownedBlocks);
+			resident->blocks = resident->ownedBlocks.data();
+			resident->blockAlign = ImaAdpcm::BlockAlign(channels);
+		}
+		resident->blockFrames = ImaAdpcm::FramesPerBlock(resident->blockAlign, channels);
+		resident->size =
+			((info_.totalFrames + resident->blockFrames - 1) / resident->blockFrames) * resident->blockAlign;
+	}
+	else {
+		return false;
+	}
+
+	resident_ = resident;
+	std::vector<int16_t>{ }.swap(blockCache_);
+	cachedBlock_ = NO_BLOCK;
+	if (realtime_) {
+		prepareRealtime();
+	}
+	return true;
+}
+
+// ====================================================================================================================
+bool AudioFile::setRealtime(bool enabled)
+{
+	if (!file_ || ((lastError_ != AudioError::NO_ERROR) && (lastError_ != AudioError::READ_AT_END))) {
+		return false;
+	}
+	if (enabled && !realtime_) {
+		prepareRealtime();
+	}
+	realtime_ = enabled;
+	return true;
+}
+
+// ====================================================================================================================
+void AudioFile::prepareRealtime()
+{
+	// Build the seek index now instead of on the first seek (failure falls back to decoder probing, which does not
+	// allocate), and collect any background build, which would otherwise join the builder thread in a seek
+	if (SupportsSeekIndex(type_)) {
+		buildSeekIndex();
+	}
+
+	// Reserve the partial block cache and the reverse read block
+	if (resident_ && (resident_->residency == AudioResidency::IMA_ADPCM)) {
+		blockCache_.resize(size_t(resident_->blockFrames * info_.channels));
+	}
+	reverseBlock_.resize(size_t(REVERSE_BLOCK_FRAMES * info_.channels));
+
+	// Resident data copied out of the file does not need the file pages
+	if (!resident_ || (resident_->ownedPCM.empty() && resident_->ownedBlocks.empty())) {
+		file_->prefault();
+	}
+}
+
+// ====================================================================================================================
+uint64_t AudioFile::readResident(uint64_t frameCount, int16_t* buffer)
+{
+	const auto& resident = *resident_;
+	const uint64_t position = info_.totalFrames - remaining_;
+	const uint32_t channels = info_.channels;
+	if (resident.residency == AudioResidency::PCM) {
+		std::memcpy(buffer, resident.pcm + (position * channels), size_t(frameCount * channels * sizeof(int16_t)));
+		return frameCount;
+	}
+
+	const uint32_t blockFrames = resident.blockFrames;
+	const uint64_t fullBlocks = info_.totalFrames / blockFrames;
+	uint64_t count = 0;
+	while (count < frameCount) {
+		const uint64_t frame = position + count;
+		const uint64_t block = frame / blockFrames;
+		const uint64_t offset = frame % blockFrames;
+		int16_t* const output = buffer + (count * channels);
+
+		// Complete blocks are decoded directly into the output
+		const uint64_t direct = ((offset == 0) && (block < fullBlocks))
+			? std::min((frameCount - count) / blockFrames, fullBlocks - block)
+			: 0;
+		if (direct > 0) {
+			if (!ImaAdpcm::DecodeBlocks(resident.blocks + (block * resident.blockAlign), direct, resident.blockAlign,
+					channels, output)) {
+				return count;
+			}
+			count += direct * blockFrames;
+			continue;
+		}
+
+		// Partial blocks are decoded into the cache
+		if (cachedBlock_ != block) {
+			blockCache_.resize(size_t(blockFrames * channels));
+			if (!ImaAdpcm::DecodeBlocks(resident.blocks + (block * resident.blockAlign), 1, resident.blockAlign,
+					channels, blockCache_.data())) {
+				cachedBlock_ = NO_BLOCK;
+				return count;
+			}
+			cachedBlock_ = block;
+		}
+		const uint64_t length = std::min(uint64_t(blockFrames - offset), frameCount - count);
+		std::memcpy(output, blockCache_.data() + (offset * channels), size_t(length * channels * sizeof(int16_t)));
+		count += length;
+	}
+	return count;
+}
+
+// ====================================================================================================================
+bool AudioFile::buildSeekIndex()
+{
+	if (hasError() || !SupportsSeekIndex(type_)) {
+		return false;
+	}
+	if (hasSeekIndex() || collectSeekIndex(true)) {
+		return true;
+	}
+
+	const bool built = (type_ == AudioType::VORBIS)
+		? seekIndex_.buildVorbis(file_->data(), file_->size())
+		: seekIndex_.buildFlac(file_->data(), file_->size());
+	if (!built) {
+		return false;
+	}
+	applySeekIndex();
+	return true;
+}
+
+// ====================================================================================================================
+bool AudioFile::buildSeekIndexAsync()
+{
+	if (hasError() || !SupportsSeekIndex(type_)) {
+		return false;
+	}
+	if (hasSeekIndex() || indexThread_.joinable()) {
+		return true;
+	}
+
+	// The builder only touches the pending index, which is not read until the ready flag is set
+	indexReady_.store(false);
+	indexThread_ = std::thread([this]() {
+		if (type_ == AudioType::VORBIS) {
+			pendingIndex_.buildVorbis(file_->data(), file_->size());
+		}
+		else {
+			pendingIndex_.buildFlac(file_->data(), file_->size());
+		}
+		indexReady_.store(true, std::memory_order_release);
+	});
+	return true;
+}
+
+// ====================================================================================================================
+bool AudioFile::saveSeekIndex(const std::string& path) const
+{
+	return hasSeekIndex() && seekIndex_.save(path.empty() ? (path_ + ".seek") : path, file_->data());
+}
+
+// ====================================================================================================================
+bool AudioFile::loadSeekIndex(const std::string& path)
+{
+	if (hasError() || !SupportsSeekIndex(type_)) {
+		return false;
+	}
+
+	collectSeekIndex(true);
+	const uint64_t firstOffset = (type_ == AudioType::FLAC) ? handle_.flac->firstFLACFramePosInBytes : 0;
+	if (!seekIndex_.load(path.empty() ? (path_ + ".seek") : path, type_, file_->data(), file_->size(), firstOffset)) {
+		return false;
+	}
+	applySeekIndex();
+	return true;
+}
+
+// ====================================================================================================================
+bool AudioFile::collectSeekIndex(bool wait)
+{
+	if (!indexThread_.joinable() || (!wait && !indexReady_.load(std::memory_order_acquire))) {
+		return false;
+	}
+
+	indexThread_.join();
+	if (pendingIndex_.empty()) {
+		return false;
+	}
+	seekIndex_.swap(pendingIndex_);
+	pendingIndex_.clear();
+	applySeekIndex();
+	return true;
+}
+
+// ====================================================================================================================
+void AudioFile::applySeekIndex()
+{
+	if (type_ == AudioType::VORBIS) {
+		// Convert to the decoder page table, which only includes pages with known positions
+		const auto& points = seekIndex_.points();
+		vorbisPages_.clear();
+		vorbisPages_.reserve(points.size());
+		for (size_t i = 0; (i + 1) < points.size(); ++i) {
+			if ((points[i].frame != SeekIndex::NO_FRAME) && (points[i].frame < UINT32_MAX)) {
+				vorbisPages_.push_back({
+					uint32_t(points[i].offset), uint32_t(points[i + 1].offset), uint32_t(points[i].frame)
+				});
+			}
+		}
+		stb_vorbis_set_page_index(handle_.vorbis, vorbisPages_.data(), int(vorbisPages_.size()));
+	}
+	else if ((type_ == AudioType::FLAC) && (handle_.flac->container == drflac_container_native)) {
+		// Replace the seek table from the file (if any) with a seek point for every frame
+		const auto& points = seekIndex_.points();
+		const uint64_t firstFrameOffset = handle_.flac->firstFLACFramePosInBytes;
+		flacSeekpoints_.clear();
+		flacSeekpoints_.reserve(points.size());
+		for (size_t i = 0; (i + 1) < points.size(); ++i) {
+			flacSeekpoints_.push_back({
+				points[i].frame, points[i].offset - firstFrameOffset, drflac_uint16(points[i + 1].frame - points[i].frame)
+			});
+		}
+		handle_.flac->pSeekpoints = flacSeekpoints_.data();
+		handle_.flac->seekpointCount = drflac_uint32(flacSeekpoints_.size());
+	}
+}
+
 // ====================================================================================================================
 AudioType AudioFile::DetectType(const std::string& path)
 {
@@ -161,3 +852,141 @@ AudioType AudioFile::DetectType(const std::string& path)
 		return AudioType::UNKNOWN;
 	}
 }
+
+// ====================================================================================================================
+bool AudioFile::SupportsSeekIndex(AudioType type)
+{
+	return (type == AudioType::VORBIS) || (type == AudioType::FLAC);
+}
+
+// ====================================================================================================================
+// Reads the stream info block at the start of a native FLAC file
+static bool ProbeFlac(std::ifstream& file, AudioInfo* info)
+{
+	uint8_t header[42];
+	if (!file.read(reinterpret_cast<char*>(header), sizeof(header)) || (std::memcmp(header, "fLaC", 4) != 0) ||
+			((header[4] & 0x7F) != 0)) {
+		return false;
+	}
+	const uint8_t* const stream = header + 8;
+	info->sampleRate = (uint32_t(stream[10]) << 12) | (uint32_t(stream[11]) << 4) | (stream[12] >> 4);
+	info->channels = ((stream[12] >> 1) & 0x07) + 1;
+	info->totalFrames = (uint64_t(stream[13] & 0x0F) << 32) | (uint64_t(stream[14]) << 24) |
+		(uint64_t(stream[15]) << 16) | (uint64_t(stream[16]) << 8) | stream[17];
+	return info->sampleRate != 0;
+}
+
+// ====================================================================================================================
+// Reads the identification header from the first page, and the length from the granule position of the last page
+static bool ProbeVorbis(std::ifstream& file, AudioInfo* info)
+{
+	// First page, which only contains the identification header
+	uint8_t page[27 + 255];
+	uint8_t ident[16];
+	if (!file.read(reinterpret_cast<char*>(page), 27) || (std::memcmp(page, "OggS", 4) != 0) || (page[4] != 0) ||
+			!file.read(reinterpret_cast<char*>(page + 27), page[26]) ||
+			!file.read(reinterpret_cast<char*>(ident), sizeof(ident)) ||
+			(ident[0] != 1) || (std::memcmp(ident + 1, "vorbis", 6) != 0)) {
+		return false;
+	}
+	uint32_t serial, version, rate;
+	std::memcpy(&serial, page + 14, sizeof(serial));
+	std::memcpy(&version, ident + 7, sizeof(version));
+	std::memcpy(&rate, ident + 12, sizeof(rate));
+	if ((version != 0) || (ident[11] == 0) || (rate == 0)) {
+		return false;
+	}
+	info->channels = ident[11];
+	info->sampleRate = rate;
+
+	// Search backwards from the end for the last complete page with a granule position, starting with the largest
+	// possible page size, which almost always contains the last page
+	file.seekg(0, std::ios::end);
+	const uint64_t size = uint64_t(file.tellg());
+	std::vector<uint8_t> tail{ };
+	for (uint64_t window = std::min<uint64_t>(size, 65536); ; window = std::min(size, window * 4)) {
+		tail.resize(size_t(window));
+		file.clear();
+		file.seekg(std::streamoff(size - window));
+		if (!file.read(reinterpret_cast<char*>(tail.data()), std::streamsize(window))) {
+			return false;
+		}
+		for (size_t pos = (window >= 27) ? size_t(window - 27) + 1 : 0; pos-- > 0; ) {
+			const uint8_t* const header = tail.data() + pos;
+			if ((std::memcmp(header, "OggS", 4) != 0) || (header[4] != 0) || (std::memcmp(header + 14, &serial, 4) != 0) ||
+					((pos + 27 + header[26]) > window)) {
+				continue;
+			}
+			uint64_t length = 27 + header[26];
+			for (uint32_t i = 0; i < header[26]; ++i) {
+				length += header[27 + i];
+			}
+			uint64_t granule;
+			std::memcpy(&granule, header + 6, sizeof(granule));
+			if (((pos + length) <= window) && (granule != UINT64_MAX)) {
+				info->totalFrames = std::min<uint64_t>(granule, 0xFFFFFFFE); // Matches the decoder
+				return true;
+			}
+		}
+		if (window == size) {
+			return false;
+		}
+	}
+}
+
+// ====================================================================================================================
+AudioError AudioFile::Probe(const std::string& path, AudioInfo* info)
+{
+	*info = { };
+	const auto type = DetectType(path);
+	if (type == AudioType::UNKNOWN) {
+		return AudioError::UNKNOWN_TYPE;
+	}
+	std::ifstream file(path, std::ios::binary);
+	if (!file.is_open()) {
+		return AudioError::FILE_NOT_FOUND;
+	}
+
+	// WAV headers are handled by the decoder, which only reads the chunks before the data
+	bool probed = false;
+	if (type == AudioType::WAV) {
+		drwav wav;
+		if (drwav_init_file(&wav, path.c_str(), nullptr)) {
+			info->totalFrames = wav.totalPCMFrameCount;
+			info->sampleRate = wav.sampleRate;
+			info->channels = wav.channels;
+			drwav_uninit(&wav);
+			probed = true;
+		}
+	}
+	else if (type == AudioType::VORBIS) {
+		probed = ProbeVorbis(file, info);
+	}
+	else {
+		probed = ProbeFlac(file, info);
+	}
+
+	// Fall back to a full open for less common layouts (such as Ogg FLAC, or unknown FLAC lengths)
+	if (!probed || (info->totalFrames == 0)) {
+		file.close();
+		const AudioFile audio{ path };
+		if (audio.hasError()) {
+			return audio.error();
+		}
+		*info = audio.info();
+	}
+	return AudioError::NO_ERROR;
+}
+
+// ====================================================================================================================
+uint32_t AudioFile::ProbeMany(const char* const* paths, uint32_t count, AudioInfo* infos, AudioError* errors)
+{
+	std::atomic<uint32_t> success{ 0 };
+	ThreadPool::Shared().parallelFor(count, [&](size_t index) {
+		errors[index] = Probe(paths[index], infos + index);
+		if (errors[index] == AudioError::NO_ERROR) {
+			success.fetch_add(1);
+		}
+	});
+	return success.load();
+}
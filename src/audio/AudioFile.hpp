@@ -7,11 +7,17 @@
 #pragma once
 
 #include "../config.hpp"
+#include "../util/MappedFile.hpp"
 
 #define STB_VORBIS_HEADER_ONLY
 #include "./dr_wav.h"
 #include "./stb_vorbis.c"
 #include "./dr_flac.h"
+#include "./SeekIndex.hpp"
+
+#include <atomic>
+#include <memory>
+#include <thread>
 
 
 // Describes the different errors that can occur during audio file loading
@@ -24,6 +30,7 @@ enum class AudioError : uint32_t
 	BAD_DATA_READ = 4,		// Reading samples failed (most likely corrupt frame data)
 	READ_AT_END = 5,		// Attempting to read a fully consumed file
 	BAD_STATE_READ = 6,		// Attempting to read from a file object that is already errored
+	BAD_SEEK = 7,			// Seeking to a frame failed (most likely corrupt frame data)
 }; // enum class AudioError
 
 
@@ -37,6 +44,15 @@ enum class AudioType : uint32_t
 }; // enum class AudioType
 
 
+// Describes how the audio data for a handle is held in memory
+enum class AudioResidency : uint32_t
+{
+	STREAM = 0,		// Decoded on demand from the file contents
+	PCM = 1,		// Fully decoded 16-bit PCM data
+	IMA_ADPCM = 2,	// IMA ADPCM blocks (lossy, ~4x smaller than PCM), decoded on demand
+}; // enum class AudioResidency
+
+
 // Contains metadata information about an audio file
 struct AudioInfo final
 {
@@ -49,12 +65,20 @@ public:
 
 // Represents a handle to a sound file for reading and streaming
 // This type is the opaque pointer type used in the exported C# API
+// The file contents are memory mapped, and are shared with any clones of the handle
 class AudioFile final
 {
 public:
 	explicit AudioFile(const std::string& path);
 	~AudioFile();
 
+	AudioFile(const AudioFile&) = delete;
+	AudioFile& operator = (const AudioFile&) = delete;
+
+	// Creates a new handle for the same file with an independent read position, which shares the file contents and
+	// the parsed stream setup with this handle
+	AudioFile* clone() const;
+
 	inline const std::string& path() const { return path_; }
 	inline AudioType type() const { return type_; }
 	inline const AudioInfo& info() const { return info_; }
@@ -64,12 +88,87 @@ public:
 
 	// Returns the actual number of frames read, or 0 for an error
 	uint64_t readFrames(uint64_t frameCount, int16_t* buffer);
+	// Reads the frames before the read position in reverse order, moving the read position backwards, and returns the
+	// actual number of frames read, or 0 for an error (READ_AT_END at the start of the file)
+	// Blocks of frames are decoded forward into a fixed size scratch buffer, and emitted in reverse
+	uint64_t readFramesReverse(uint64_t frameCount, int16_t* buffer);
+	// Moves the read position to the given frame, which can also recover from reaching the end of the file
+	bool seek(uint64_t frame);
+	// Gets a view of the complete interleaved PCM data of the file, independent of the read position
+	// 16-bit PCM WAV data is referenced directly in the mapped file, other files are decoded into memory owned by the
+	// handle on the first call. Views stay valid until the handle is destroyed or its residency is changed.
+	bool mapPCM(const int16_t** data, uint64_t* frames);
+	// Same as mapPCM, but with the leading and trailing silence removed from the view, where silence is any frame with
+	// no sample magnitudes above the threshold. Trimmed decodes only allocate memory for the trimmed data, and are kept
+	// separately for each threshold, so mapping with another threshold does not invalidate earlier views.
+	bool mapTrimmedPCM(uint16_t threshold, const int16_t** data, uint64_t* frames, uint64_t* leadFrames,
+		uint64_t* tailFrames);
+
+	// Moves the audio data into memory with the given representation, which is shared with clones made afterwards
+	// Resident handles read and seek without the file decoder. IMA ADPCM WAV files are used directly from the file
+	// contents, other files are decoded and re-encoded. Changing the residency invalidates any mapped PCM views.
+	bool makeResident(AudioResidency residency);
+	inline AudioResidency residency() const { return resident_ ? resident_->residency : AudioResidency::STREAM; }
+	inline uint64_t residentSize() const { return resident_ ? resident_->size : 0; }
+
+	// Real-time mode performs all allocations and file access up front, after which reads and seeks do not allocate,
+	// take locks, or wait on the disk (reads are checked when built with VEGA_REALTIME_CHECKS)
+	bool setRealtime(bool enabled);
+	inline bool realtime() const { return realtime_; }
+
+	// Seek index management, for file types that support indexed seeking
+	bool buildSeekIndex();
+	// Builds the seek index on a background thread, which is picked up by the first seek after it completes
+	bool buildSeekIndexAsync();
+	bool saveSeekIndex(const std::string& path) const;
+	bool loadSeekIndex(const std::string& path);
+	inline bool hasSeekIndex() const { return !seekIndex_.empty(); }
 
 	static AudioType DetectType(const std::string& path);
+	static bool SupportsSeekIndex(AudioType type);
+	// Reads the info for a file from the minimum number of header bytes, without fully opening the file
+	static AudioError Probe(const std::string& path, AudioInfo* info);
+	// Probes a set of files in parallel on the shared thread pool, returns the number of successful probes
+	static uint32_t ProbeMany(const char* const* paths, uint32_t count, AudioInfo* infos, AudioError* errors);
 	
+private:
+	// Audio data for resident handles, which can reference the file contents or own the data
+	struct Resident final
+	{
+	public:
+		AudioResidency residency;
+		uint64_t size;			// The size of the resident data, in bytes
+		const int16_t* pcm;		// PCM residency only
+		const uint8_t* blocks;	// IMA_ADPCM residency only
+		uint32_t blockAlign;
+		uint32_t blockFrames;
+		std::vector<int16_t> ownedPCM;
+		std::vector<uint8_t> ownedBlocks;
+	}; // struct Resident
+	// Decoded PCM data with the leading and trailing silence removed
+	struct TrimmedPCM final
+	{
+	public:
+		uint16_t threshold;
+		uint64_t leadFrames;
+		std::vector<int16_t> pcm;
+	}; // struct TrimmedPCM
+
+	explicit AudioFile(const AudioFile* source);
+
+	bool collectSeekIndex(bool wait);
+	void applySeekIndex();
+	const int16_t* findDirectPCM() const;
+	const uint8_t* findDirectAdpcm() const;
+	uint64_t readResident(uint64_t frameCount, int16_t* buffer);
+	void prepareRealtime();
+	bool decodePCM(int32_t threshold, std::vector<int16_t>* output, uint64_t* leadFrames) const;
+
 private:
 	const std::string path_;
 	const AudioType type_;
+	std::shared_ptr<const MappedFile> file_;
+	std::shared_ptr<stb_vorbis> vorbisSetup_; // The decoder that owns the shared vorbis setup tables
 	union
 	{
 		drwav* wav;
@@ -79,4 +178,25 @@ private:
 	AudioInfo info_;
 	uint64_t remaining_;
 	AudioError lastError_;
+	SeekIndex seekIndex_;
+	std::vector<stb_vorbis_page_info> vorbisPages_;
+	std::vector<drflac_seekpoint> flacSeekpoints_;
+	std::thread indexThread_;
+	std::atomic_bool indexReady_;
+	SeekIndex pendingIndex_;
+	std::vector<int16_t> decodedPCM_; // The full decoded data, once returned by mapPCM
+	bool pcmDecoded_;
+	std::vector<TrimmedPCM> trimmedPCM_; // The trimmed decoded data for each threshold, never replaced once returned
+	std::shared_ptr<const Resident> resident_;
+	std::vector<int16_t> blockCache_; // The most recent partially read ADPCM block
+	uint64_t cachedBlock_;
+	bool realtime_;
+	std::vector<int16_t> reverseBlock_; // The decoded frames for reverse reads
+	uint64_t reverseStart_;
+	uint64_t reverseFrames_;
+	bool needsSeek_; // If the decoder is not at the read position after reverse reads
+
+	static constexpr int32_t NO_TRIM{ -1 };
+	static constexpr uint64_t NO_BLOCK{ UINT64_MAX };
+	static constexpr uint64_t REVERSE_BLOCK_FRAMES{ 4096 };
 }; // class AudioFile
@@ -0,0 +1,229 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#include "./AudioPlaylist.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+
+// The number of source frames decoded at once for each file
+static constexpr uint64_t CHUNK_FRAMES{ 4096 };
+
+
+// ====================================================================================================================
+// Converts frames between channel counts: mono is duplicated to all channels, all channels are averaged to mono, and
+// otherwise the shared channels are copied with any extra output channels left silent
+static void RemapFrames(const int16_t* src, uint32_t srcChannels, int16_t* dst, uint32_t dstChannels, uint64_t frames)
+{
+	if (srcChannels == dstChannels) {
+		std::memcpy(dst, src, size_t(frames * srcChannels * sizeof(int16_t)));
+		return;
+	}
+	for (uint64_t fi = 0; fi < frames; ++fi, src += srcChannels, dst += dstChannels) {
+		if (srcChannels == 1) {
+			std::fill(dst, dst + dstChannels, src[0]);
+		}
+		else if (dstChannels == 1) {
+			int32_t sum = 0;
+			for (uint32_t ci = 0; ci < srcChannels; ++ci) {
+				sum += src[ci];
+			}
+			dst[0] = int16_t(sum / int32_t(srcChannels));
+		}
+		else {
+			const uint32_t shared = std::min(srcChannels, dstChannels);
+			std::memcpy(dst, src, shared * sizeof(int16_t));
+			std::fill(dst + shared, dst + dstChannels, int16_t(0));
+		}
+	}
+}
+
+
+// The decoding and conversion state of a single file
+struct AudioPlaylist::Segment final
+{
+public:
+	std::unique_ptr<AudioFile> file;
+	AudioError error;
+	uint32_t channels;				// The output channel count
+	uint64_t step;					// Source frames per output frame (32.32 fixed point), or zero for no resampling
+	std::vector<int16_t> chunk;		// Decoded source frames
+	std::vector<int16_t> window;	// Source frames remapped to the output channels
+	uint64_t windowFrames;
+	uint64_t windowPos;				// Frame index, or 32.32 fixed point position when resampling
+	bool ended;						// If the file has been fully decoded into the window
+
+	// Opens the file and prerolls the first chunk
+	void open(const std::string& path, uint32_t sampleRate, uint32_t outChannels)
+	{
+		file.reset(new AudioFile(path));
+		error = file->error();
+		if (error != AudioError::NO_ERROR) {
+			return;
+		}
+		const auto& info = file->info();
+		channels = outChannels;
+		step = (info.sampleRate == sampleRate) ? 0 : ((uint64_t(info.sampleRate) << 32) / sampleRate);
+		chunk.resize(size_t(CHUNK_FRAMES * info.channels));
+		window.resize(size_t((CHUNK_FRAMES + 1) * channels));
+		fill();
+	}
+
+	// Decodes the next chunk of the file into the window, keeping the last window frame at the start when resampling
+	// so that it can be interpolated with the new frames
+	void fill()
+	{
+		const uint64_t keep = ((step != 0) && (windowFrames > 0)) ? 1 : 0;
+		if (keep) {
+			std::memcpy(window.data(), window.data() + ((windowFrames - 1) * channels), channels * sizeof(int16_t));
+			windowPos -= (windowFrames - 1) << 32;
+		}
+		else {
+			windowPos = 0;
+		}
+		windowFrames = keep;
+
+		const uint64_t count = std::min(CHUNK_FRAMES, file->remaining());
+		if ((count > 0) && (file->readFrames(count, chunk.data()) != count)) {
+			error = file->error();
+			ended = true;
+			return;
+		}
+		RemapFrames(chunk.data(), file->info().channels, window.data() + (keep * channels), channels, count);
+		windowFrames += count;
+		ended = (file->remaining() == 0);
+	}
+
+	// Reads converted frames, returns less than requested only once the file is finished (or has an error)
+	uint64_t read(uint64_t frameCount, int16_t* buffer)
+	{
+		uint64_t count = 0;
+		while ((count < frameCount) && (error == AudioError::NO_ERROR)) {
+			int16_t* dst = buffer + (count * channels);
+			if (step == 0) {
+				const uint64_t length = std::min(windowFrames - windowPos, frameCount - count);
+				std::memcpy(dst, window.data() + (windowPos * channels), size_t(length * channels * sizeof(int16_t)));
+				windowPos += length;
+				count += length;
+			}
+			else {
+				// Linear interpolation between the window frames around the position
+				for (uint64_t index; (count < frameCount) && (((index = (windowPos >> 32)) + 1) < windowFrames); ) {
+					const int64_t frac = int64_t(windowPos & 0xFFFFFFFF);
+					const int16_t* const a = window.data() + (index * channels);
+					const int16_t* const b = a + channels;
+					for (uint32_t ci = 0; ci < channels; ++ci) {
+						dst[ci] = int16_t(a[ci] + (((int64_t(b[ci]) - a[ci]) * frac) >> 32));
+					}
+					dst += channels;
+					windowPos += step;
+					++count;
+				}
+			}
+			if (count < frameCount) {
+				if (ended) {
+					break;
+				}
+				fill();
+			}
+		}
+		return count;
+	}
+}; // struct AudioPlaylist::Segment
+
+
+// ====================================================================================================================
+AudioPlaylist::AudioPlaylist(uint32_t sampleRate, uint32_t channels)
+	: sampleRate_{ sampleRate }
+	, channels_{ channels }
+	, queue_{ }
+	, current_{ }
+	, next_{ }
+	, loader_{ }
+	, segmentCount_{ 0 }
+	, lastError_{ AudioError::NO_ERROR }
+{
+
+}
+
+// ====================================================================================================================
+AudioPlaylist::~AudioPlaylist()
+{
+	if (loader_.joinable()) {
+		loader_.join();
+	}
+}
+
+// ====================================================================================================================
+bool AudioPlaylist::append(const std::string& path)
+{
+	if (AudioFile::DetectType(path) == AudioType::UNKNOWN) {
+		return false;
+	}
+	queue_.push_back(path);
+	startLoad();
+	return true;
+}
+
+// ====================================================================================================================
+uint64_t AudioPlaylist::readFrames(uint64_t frameCount, int16_t* buffer)
+{
+	// Fill from the current file, moving to the next file once it is exhausted
+	uint64_t count = 0;
+	while (count < frameCount) {
+		if (!current_ && !advance()) {
+			break;
+		}
+		count += current_->read(frameCount - count, buffer + (count * channels_));
+		if (count < frameCount) {
+			if (current_->error != AudioError::NO_ERROR) {
+				lastError_ = current_->error;
+			}
+			current_.reset();
+		}
+	}
+	return count;
+}
+
+// ====================================================================================================================
+bool AudioPlaylist::advance()
+{
+	while (true) {
+		startLoad();
+		if (!loader_.joinable()) {
+			return false;
+		}
+
+		// The loader is usually finished long before the current file, in which case this does not block
+		loader_.join();
+		current_ = std::move(next_);
+		startLoad();
+		++segmentCount_;
+		if (current_->error == AudioError::NO_ERROR) {
+			return true;
+		}
+		lastError_ = current_->error;
+		current_.reset();
+	}
+}
+
+// ====================================================================================================================
+void AudioPlaylist::startLoad()
+{
+	if (loader_.joinable() || queue_.empty()) {
+		return;
+	}
+	const std::string path{ queue_.front() };
+	queue_.pop_front();
+
+	// Open and preroll the first chunk of the file
+	loader_ = std::thread([this, path]() {
+		std::unique_ptr<Segment> seg{ new Segment{ } };
+		seg->open(path, sampleRate_, channels_);
+		next_ = std::move(seg);
+	});
+}
@@ -0,0 +1,53 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include "./AudioFile.hpp"
+
+#include <deque>
+
+
+// Plays a queue of audio files back to back as a single gapless stream with a fixed output format
+// The next file is opened and prerolled on a background thread while the current file plays, and reads are filled
+// across file boundaries. Files with a different format are resampled (linear) and have their channels remapped.
+// Files that fail to open are skipped, with the error reported by error().
+class AudioPlaylist final
+{
+public:
+	AudioPlaylist(uint32_t sampleRate, uint32_t channels);
+	~AudioPlaylist();
+
+	AudioPlaylist(const AudioPlaylist&) = delete;
+	AudioPlaylist& operator = (const AudioPlaylist&) = delete;
+
+	inline uint32_t sampleRate() const { return sampleRate_; }
+	inline uint32_t channels() const { return channels_; }
+	inline AudioError error() const { return lastError_; }
+	// The number of files started so far, including the current file
+	inline uint32_t segmentCount() const { return segmentCount_; }
+
+	// Adds a file to the end of the queue
+	bool append(const std::string& path);
+	// Returns the actual number of frames read, which is only less than requested at the end of the queue
+	uint64_t readFrames(uint64_t frameCount, int16_t* buffer);
+
+private:
+	struct Segment;
+
+	bool advance();
+	void startLoad();
+
+private:
+	const uint32_t sampleRate_;
+	const uint32_t channels_;
+	std::deque<std::string> queue_;
+	std::unique_ptr<Segment> current_;
+	std::unique_ptr<Segment> next_; // Written by the loader thread until it is joined
+	std::thread loader_;
+	uint32_t segmentCount_;
+	AudioError lastError_;
+}; // class AudioPlaylist
@@ -0,0 +1,198 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#include "./AudioScheduler.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+
+// The largest number of frames decoded for a stream at once
+static constexpr uint64_t DECODE_FRAMES{ 4096 };
+
+
+// ====================================================================================================================
+AudioScheduler::AudioScheduler(uint32_t workerCount)
+	: workers_{ }
+	, mutex_{ }
+	, workCond_{ }
+	, idleCond_{ }
+	, streams_{ }
+	, nextId_{ 1 }
+	, stop_{ false }
+{
+	// Default to half of the hardware threads, leaving room for the mixer and the rest of the application
+	if (workerCount == 0) {
+		workerCount = std::max(std::thread::hardware_concurrency() / 2, 1u);
+	}
+	workers_.reserve(workerCount);
+	for (uint32_t i = 0; i < workerCount; ++i) {
+		workers_.emplace_back([this]() { workerMain(); });
+	}
+}
+
+// ====================================================================================================================
+AudioScheduler::~AudioScheduler()
+{
+	{
+		std::lock_guard<std::mutex> lock{ mutex_ };
+		stop_ = true;
+	}
+	workCond_.notify_all();
+	for (auto& worker : workers_) {
+		worker.join();
+	}
+}
+
+// ====================================================================================================================
+uint32_t AudioScheduler::addStream(AudioFile* file, uint32_t bufferFrames)
+{
+	if (!file || file->hasError() || (bufferFrames == 0)) {
+		return 0;
+	}
+
+	std::shared_ptr<Stream> stream{ new Stream{ } };
+	stream->file = file;
+	stream->ring.resize(size_t(bufferFrames) * file->info().channels);
+	stream->capacity = bufferFrames;
+	stream->error = (file->remaining() == 0) ? AudioError::READ_AT_END : AudioError::NO_ERROR;
+
+	uint32_t id;
+	{
+		std::lock_guard<std::mutex> lock{ mutex_ };
+		id = nextId_++;
+		streams_[id] = stream;
+	}
+	workCond_.notify_one();
+	return id;
+}
+
+// ====================================================================================================================
+bool AudioScheduler::removeStream(uint32_t id)
+{
+	std::unique_lock<std::mutex> lock{ mutex_ };
+	const auto it = streams_.find(id);
+	if (it == streams_.end()) {
+		return false;
+	}
+	const auto stream = it->second;
+	streams_.erase(it);
+	idleCond_.wait(lock, [&stream]() { return !stream->decoding; });
+	return true;
+}
+
+// ====================================================================================================================
+uint64_t AudioScheduler::readFrames(uint32_t id, uint64_t frameCount, int16_t* buffer)
+{
+	std::shared_ptr<Stream> stream;
+	uint64_t count;
+	{
+		std::lock_guard<std::mutex> lock{ mutex_ };
+		const auto it = streams_.find(id);
+		if (it == streams_.end()) {
+			return 0;
+		}
+		stream = it->second;
+		count = std::min(frameCount, stream->buffered);
+		if ((count < frameCount) && (stream->error == AudioError::NO_ERROR)) {
+			++stream->underruns;
+		}
+	}
+
+	if (count == 0) {
+		return 0;
+	}
+
+	// The buffered frames are not written by the workers until they are released below, so can be copied unlocked
+	const uint32_t channels = stream->file->info().channels;
+	const uint64_t first = std::min(count, stream->capacity - stream->readPos);
+	std::memcpy(buffer, stream->ring.data() + (stream->readPos * channels),
+		size_t(first * channels * sizeof(int16_t)));
+	std::memcpy(buffer + (first * channels), stream->ring.data(), size_t((count - first) * channels * sizeof(int16_t)));
+
+	// Release the frames to the workers
+	{
+		std::lock_guard<std::mutex> lock{ mutex_ };
+		stream->readPos = (stream->readPos + count) % stream->capacity;
+		stream->buffered -= count;
+	}
+	workCond_.notify_one();
+	return count;
+}
+
+// ====================================================================================================================
+bool AudioScheduler::getStatus(uint32_t id, AudioStreamStatus* status) const
+{
+	std::lock_guard<std::mutex> lock{ mutex_ };
+	const auto it = streams_.find(id);
+	if (it == streams_.end()) {
+		return false;
+	}
+	status->bufferedFrames = it->second->buffered;
+	status->underruns = it->second->underruns;
+	status->error = it->second->error;
+	return true;
+}
+
+// ====================================================================================================================
+void AudioScheduler::workerMain()
+{
+	std::unique_lock<std::mutex> lock{ mutex_ };
+	while (true) {
+		std::shared_ptr<Stream> stream;
+		workCond_.wait(lock, [this, &stream]() { return stop_ || (stream = pickStream()); });
+		if (stop_) {
+			break;
+		}
+
+		// Decode into the contiguous free space after the write position, without holding the lock
+		stream->decoding = true;
+		const uint32_t channels = stream->file->info().channels;
+		const uint64_t writePos = (stream->readPos + stream->buffered) % stream->capacity;
+		const uint64_t space = std::min(stream->capacity - stream->buffered, stream->capacity - writePos);
+		const uint64_t count = std::min(space, DECODE_FRAMES);
+		lock.unlock();
+		const uint64_t actual = stream->file->readFrames(count, stream->ring.data() + (writePos * channels));
+		const AudioError error = (actual == 0)
+			? stream->file->error()
+			: ((stream->file->remaining() == 0) ? AudioError::READ_AT_END : AudioError::NO_ERROR);
+		lock.lock();
+
+		stream->buffered += actual;
+		stream->error = error;
+		stream->decoding = false;
+		idleCond_.notify_all();
+		if (error == AudioError::NO_ERROR) {
+			workCond_.notify_one(); // Another worker might be able to take a different stream
+		}
+	}
+}
+
+// ====================================================================================================================
+std::shared_ptr<AudioScheduler::Stream> AudioScheduler::pickStream() const
+{
+	// Earliest deadline first, where the deadline is the playback time of the buffered frames
+	// Streams are only refilled once a reasonably sized decode fits, to avoid many tiny decodes
+	std::shared_ptr<Stream> best{ };
+	double bestLead = 0;
+	for (const auto& pair : streams_) {
+		const auto& stream = pair.second;
+		if (stream->decoding || (stream->error != AudioError::NO_ERROR)) {
+			continue;
+		}
+		const uint64_t space = stream->capacity - stream->buffered;
+		const uint64_t minimum = std::min(std::min(DECODE_FRAMES, stream->capacity / 4), stream->file->remaining());
+		if ((space == 0) || (space < minimum)) {
+			continue;
+		}
+		const double lead = double(stream->buffered) / stream->file->info().sampleRate;
+		if (!best || (lead < bestLead)) {
+			best = stream;
+			bestLead = lead;
+		}
+	}
+	return best;
+}
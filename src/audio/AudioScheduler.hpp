@@ -0,0 +1,75 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include "./AudioFile.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <unordered_map>
+
+
+// Contains the buffering state of a scheduled stream
+struct AudioStreamStatus final
+{
+public:
+	uint64_t bufferedFrames;	// The number of decoded frames ready to read
+	uint64_t underruns;			// The number of reads that could not be completely filled
+	AudioError error;			// The decoder state, which is READ_AT_END once the whole file has been decoded
+}; // struct AudioStreamStatus
+
+
+// Decodes a set of audio streams ahead of playback on a pool of worker threads
+// Each stream buffers decoded frames in a ring buffer, and the workers always refill the stream with the least
+// buffered playback time (the earliest deadline) first. Streams are read from the buffer, never from the decoder.
+class AudioScheduler final
+{
+public:
+	explicit AudioScheduler(uint32_t workerCount);
+	~AudioScheduler();
+
+	AudioScheduler(const AudioScheduler&) = delete;
+	AudioScheduler& operator = (const AudioScheduler&) = delete;
+
+	inline uint32_t workerCount() const { return uint32_t(workers_.size()); }
+
+	// Adds a stream that decodes from the current position of the handle, which is used exclusively by the scheduler
+	// until the stream is removed. Returns the stream id, or zero if the handle cannot be read.
+	uint32_t addStream(AudioFile* file, uint32_t bufferFrames);
+	// Removes the stream, waiting for any active decode of the stream to complete
+	bool removeStream(uint32_t id);
+	// Reads buffered frames, returns the number of frames read, which can be less than requested
+	// Reads that are not filled before the end of the stream are counted as underruns
+	uint64_t readFrames(uint32_t id, uint64_t frameCount, int16_t* buffer);
+	bool getStatus(uint32_t id, AudioStreamStatus* status) const;
+
+private:
+	struct Stream final
+	{
+	public:
+		AudioFile* file;
+		std::vector<int16_t> ring;
+		uint64_t capacity;		// Ring size, in frames
+		uint64_t readPos;		// Ring read position, in frames
+		uint64_t buffered;		// Frames in the ring
+		uint64_t underruns;
+		AudioError error;
+		bool decoding;			// If a worker is writing to the ring
+	}; // struct Stream
+
+	void workerMain();
+	std::shared_ptr<Stream> pickStream() const;
+
+private:
+	std::vector<std::thread> workers_;
+	mutable std::mutex mutex_;
+	std::condition_variable workCond_;	// Signaled when a stream might need decoding
+	std::condition_variable idleCond_;	// Signaled when a worker finishes decoding a stream
+	std::unordered_map<uint32_t, std::shared_ptr<Stream>> streams_;
+	uint32_t nextId_;
+	bool stop_;
+}; // class AudioScheduler
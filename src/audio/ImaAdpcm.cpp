@@ -0,0 +1,219 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#include "./ImaAdpcm.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <emmintrin.h>
+
+
+static constexpr int32_t STEP_TABLE[89]{
+	7,     8,     9,     10,    11,    12,    13,    14,    16,    17,
+	19,    21,    23,    25,    28,    31,    34,    37,    41,    45,
+	50,    55,    60,    66,    73,    80,    88,    97,    107,   118,
+	130,   143,   157,   173,   190,   209,   230,   253,   279,   307,
+	337,   371,   408,   449,   494,   544,   598,   658,   724,   796,
+	876,   963,   1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,
+	2272,  2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,  5358,
+	5894,  6484,  7132,  7845,  8630,  9493,  10442, 11487, 12635, 13899,
+	15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+static constexpr int32_t INDEX_TABLE[16]{
+	-1, -1, -1, -1, 2, 4, 6, 8,
+	-1, -1, -1, -1, 2, 4, 6, 8
+};
+static constexpr int32_t MAX_STEP_INDEX{ 88 };
+
+// Per-channel encoder state, carried between blocks
+struct EncoderState final
+{
+public:
+	int32_t predictor;
+	int32_t stepIndex;
+}; // struct EncoderState
+
+// The input for one decoded channel of one block
+struct DecodeLane final
+{
+public:
+	const uint8_t* header;
+	const uint8_t* data;	// The first nibble group
+	size_t dataStride;		// Bytes between nibble groups
+	int16_t* pcm;			// The output for the first frame
+	size_t pcmStride;		// Samples between frames
+}; // struct DecodeLane
+
+
+// ====================================================================================================================
+// Chooses the nibble for a sample, and advances the state with the same arithmetic as the decoder
+static inline uint8_t EncodeSample(EncoderState& state, int32_t sample)
+{
+	const int32_t step = STEP_TABLE[state.stepIndex];
+	int32_t delta = sample - state.predictor;
+	uint8_t nibble = 0;
+	if (delta < 0) {
+		nibble = 8;
+		delta = -delta;
+	}
+	if (delta >= step) { nibble |= 4; delta -= step; }
+	if (delta >= (step >> 1)) { nibble |= 2; delta -= (step >> 1); }
+	if (delta >= (step >> 2)) { nibble |= 1; }
+
+	int32_t diff = step >> 3;
+	if (nibble & 1) diff += step >> 2;
+	if (nibble & 2) diff += step >> 1;
+	if (nibble & 4) diff += step;
+	if (nibble & 8) diff = -diff;
+	state.predictor = std::min(std::max(state.predictor + diff, int32_t(INT16_MIN)), int32_t(INT16_MAX));
+	state.stepIndex = std::min(std::max(state.stepIndex + INDEX_TABLE[nibble], 0), MAX_STEP_INDEX);
+	return nibble;
+}
+
+// ====================================================================================================================
+void ImaAdpcm::Encode(const int16_t* pcm, uint64_t frames, uint32_t channels, std::vector<uint8_t>* blocks)
+{
+	const uint32_t blockAlign = BlockAlign(channels);
+	const uint32_t blockFrames = FramesPerBlock(blockAlign, channels);
+	const uint32_t groupCount = (blockFrames - 1) / 8;
+	const uint64_t blockCount = (frames + blockFrames - 1) / blockFrames;
+	blocks->assign(size_t(blockCount * blockAlign), 0);
+
+	std::vector<EncoderState> states(channels, EncoderState{ 0, 0 });
+	for (uint64_t bi = 0; bi < blockCount; ++bi) {
+		uint8_t* const block = blocks->data() + (bi * blockAlign);
+		const uint64_t first = bi * blockFrames;
+		const auto sample = [=](uint64_t frame, uint32_t ch) -> int32_t {
+			return (frame < frames) ? pcm[(frame * channels) + ch] : 0;
+		};
+
+		for (uint32_t ch = 0; ch < channels; ++ch) {
+			// Header, which resets the predictor to the exact first sample
+			auto& state = states[ch];
+			state.predictor = sample(first, ch);
+			const int16_t initial = int16_t(state.predictor);
+			std::memcpy(block + (4 * ch), &initial, sizeof(initial));
+			block[(4 * ch) + 2] = uint8_t(state.stepIndex);
+
+			// Nibble groups, low nibble first
+			for (uint32_t gi = 0; gi < groupCount; ++gi) {
+				uint8_t* const group = block + (4 * channels) + (4 * channels * gi) + (4 * ch);
+				const uint64_t frame = first + 1 + (8 * gi);
+				for (uint32_t bj = 0; bj < 4; ++bj) {
+					const uint8_t lo = EncodeSample(state, sample(frame + (2 * bj), ch));
+					const uint8_t hi = EncodeSample(state, sample(frame + (2 * bj) + 1, ch));
+					group[bj] = uint8_t(lo | (hi << 4));
+				}
+			}
+		}
+	}
+}
+
+// ====================================================================================================================
+// Decodes four channel sequences in parallel, one per 32-bit lane
+static void DecodeLanes(const DecodeLane* lanes, uint32_t groupCount)
+{
+	alignas(16) int32_t stepIndex[4];
+	alignas(16) int32_t output[4];
+	for (uint32_t li = 0; li < 4; ++li) {
+		int16_t initial;
+		std::memcpy(&initial, lanes[li].header, sizeof(initial));
+		output[li] = initial;
+		stepIndex[li] = lanes[li].header[2];
+		*lanes[li].pcm = initial;
+	}
+	auto predictor = _mm_load_si128(reinterpret_cast<const __m128i*>(output));
+	auto index = _mm_load_si128(reinterpret_cast<const __m128i*>(stepIndex));
+
+	const auto one = _mm_set1_epi32(1), two = _mm_set1_epi32(2), three = _mm_set1_epi32(3);
+	const auto four = _mm_set1_epi32(4), eight = _mm_set1_epi32(8), low = _mm_set1_epi32(0x0F);
+	const auto zero = _mm_setzero_si128(), maxIndex = _mm_set1_epi32(MAX_STEP_INDEX);
+	for (uint32_t gi = 0; gi < groupCount; ++gi) {
+		uint32_t words[4];
+		for (uint32_t li = 0; li < 4; ++li) {
+			std::memcpy(words + li, lanes[li].data + (gi * lanes[li].dataStride), sizeof(uint32_t));
+		}
+		auto nibbles = _mm_set_epi32(int32_t(words[3]), int32_t(words[2]), int32_t(words[1]), int32_t(words[0]));
+
+		for (uint32_t ni = 0; ni < 8; ++ni) {
+			const auto nibble = _mm_and_si128(nibbles, low);
+			nibbles = _mm_srli_epi32(nibbles, 4);
+
+			// There is no gather in SSE2, so the step lookup is scalar
+			_mm_store_si128(reinterpret_cast<__m128i*>(stepIndex), index);
+			const auto step = _mm_set_epi32(STEP_TABLE[stepIndex[3]], STEP_TABLE[stepIndex[2]],
+				STEP_TABLE[stepIndex[1]], STEP_TABLE[stepIndex[0]]);
+
+			// Difference from the bits of the nibble
+			auto diff = _mm_srai_epi32(step, 3);
+			const auto b0 = _mm_cmpeq_epi32(_mm_and_si128(nibble, one), one);
+			const auto b1 = _mm_cmpeq_epi32(_mm_and_si128(nibble, two), two);
+			const auto b2 = _mm_cmpeq_epi32(_mm_and_si128(nibble, four), four);
+			const auto b3 = _mm_cmpeq_epi32(_mm_and_si128(nibble, eight), eight);
+			diff = _mm_add_epi32(diff, _mm_and_si128(b0, _mm_srai_epi32(step, 2)));
+			diff = _mm_add_epi32(diff, _mm_and_si128(b1, _mm_srai_epi32(step, 1)));
+			diff = _mm_add_epi32(diff, _mm_and_si128(b2, step));
+			diff = _mm_sub_epi32(_mm_xor_si128(diff, b3), b3);
+
+			// Saturating pack performs the clamp to the 16-bit range
+			const auto packed = _mm_packs_epi32(_mm_add_epi32(predictor, diff), zero);
+			predictor = _mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16);
+
+			// Index table is -1 without bit 2, and (2 * (nibble & 3)) + 2 with bit 2, then clamped with 16-bit min/max
+			// (the indices are small enough that the upper halves of the lanes are always zero after clamping)
+			const auto inc = _mm_add_epi32(_mm_slli_epi32(_mm_and_si128(nibble, three), 1), two);
+			const auto delta = _mm_or_si128(_mm_and_si128(b2, inc), _mm_andnot_si128(b2, _mm_set1_epi32(-1)));
+			index = _mm_min_epi16(_mm_max_epi16(_mm_add_epi32(index, delta), zero), maxIndex);
+
+			_mm_store_si128(reinterpret_cast<__m128i*>(output), predictor);
+			const size_t frame = 1 + (8 * gi) + ni;
+			for (uint32_t li = 0; li < 4; ++li) {
+				lanes[li].pcm[frame * lanes[li].pcmStride] = int16_t(output[li]);
+			}
+		}
+	}
+}
+
+// ====================================================================================================================
+bool ImaAdpcm::DecodeBlocks(const uint8_t* blocks, uint64_t count, uint32_t blockAlign, uint32_t channels,
+	int16_t* pcm)
+{
+	const uint32_t blockFrames = FramesPerBlock(blockAlign, channels);
+	const uint32_t groupCount = (blockFrames - 1) / 8;
+
+	// Validate the headers first, so that the lanes do not need to
+	for (uint64_t bi = 0; bi < count; ++bi) {
+		for (uint32_t ch = 0; ch < channels; ++ch) {
+			if (blocks[(bi * blockAlign) + (4 * ch) + 2] > MAX_STEP_INDEX) {
+				return false;
+			}
+		}
+	}
+
+	// Each (block, channel) pair is an independent sequence, unused lanes decode silence into a dummy output
+	static const uint8_t SILENCE[4]{ 0, 0, 0, 0 };
+	int16_t sink;
+	const uint64_t total = count * channels;
+	for (uint64_t seq = 0; seq < total; seq += 4) {
+		DecodeLane lanes[4];
+		for (uint32_t li = 0; li < 4; ++li) {
+			if ((seq + li) < total) {
+				const uint64_t bi = (seq + li) / channels;
+				const uint32_t ch = uint32_t((seq + li) % channels);
+				const uint8_t* const block = blocks + (bi * blockAlign);
+				lanes[li] = {
+					block + (4 * ch), block + (4 * channels) + (4 * ch), 4 * channels,
+					pcm + (bi * blockFrames * channels) + ch, channels
+				};
+			}
+			else {
+				lanes[li] = { SILENCE, SILENCE, 0, &sink, 0 };
+			}
+		}
+		DecodeLanes(lanes, groupCount);
+	}
+	return true;
+}
@@ -0,0 +1,36 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include "../config.hpp"
+
+#include <vector>
+
+
+// Encoding and decoding of IMA ADPCM data, using the block layout of IMA (DVI) ADPCM WAV files
+// Each block starts with a 4 byte header for each channel (initial sample, step index, reserved), followed by groups of
+// 4 bytes per channel that each hold 8 samples for that channel. Decoding matches the dr_wav decoder exactly.
+class ImaAdpcm final
+{
+public:
+	// The block alignment used by the encoder, which is 1017 frames per block
+	inline static uint32_t BlockAlign(uint32_t channels) { return 512 * channels; }
+	// Checks if the block alignment is compatible with the block decoder
+	inline static bool IsValidBlockAlign(uint32_t blockAlign, uint32_t channels) {
+		return (channels > 0) && (blockAlign > (4 * channels)) && ((blockAlign % (4 * channels)) == 0);
+	}
+	// The number of frames held in each block of the given alignment
+	inline static uint32_t FramesPerBlock(uint32_t blockAlign, uint32_t channels) {
+		return (((blockAlign / channels) - 4) * 2) + 1;
+	}
+
+	// Encodes interleaved PCM into blocks, padding the final block with silence
+	static void Encode(const int16_t* pcm, uint64_t frames, uint32_t channels, std::vector<uint8_t>* blocks);
+	// Decodes complete blocks into interleaved PCM, returns false if any block header is invalid
+	static bool DecodeBlocks(const uint8_t* blocks, uint64_t count, uint32_t blockAlign, uint32_t channels,
+		int16_t* pcm);
+}; // class ImaAdpcm
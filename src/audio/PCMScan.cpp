@@ -0,0 +1,72 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#include "./PCMScan.hpp"
+
+#include <emmintrin.h>
+
+
+// Magnitude test for a single sample (the threshold is clamped so that its negation is representable)
+static inline bool IsAbove(int16_t sample, int32_t threshold)
+{
+	return (sample > threshold) || (sample < -threshold);
+}
+
+// Mask of samples in a vector with a magnitude above the threshold
+static inline int AboveMask(__m128i samples, __m128i pos, __m128i neg)
+{
+	const auto above = _mm_or_si128(_mm_cmpgt_epi16(samples, pos), _mm_cmplt_epi16(samples, neg));
+	return _mm_movemask_epi8(above);
+}
+
+
+// ====================================================================================================================
+size_t PCMScan::FindFirstAbove(const int16_t* samples, size_t count, uint16_t threshold)
+{
+	const int32_t limit = (threshold > INT16_MAX) ? INT16_MAX : int32_t(threshold);
+	const auto pos = _mm_set1_epi16(int16_t(limit));
+	const auto neg = _mm_set1_epi16(int16_t(-limit));
+
+	// 16 samples per iteration, then narrow down within the block
+	size_t i = 0;
+	for (; (i + 16) <= count; i += 16) {
+		const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + i));
+		const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + i + 8));
+		if (AboveMask(a, pos, neg) | AboveMask(b, pos, neg)) {
+			break;
+		}
+	}
+	for (; i < count; ++i) {
+		if (IsAbove(samples[i], limit)) {
+			return i;
+		}
+	}
+	return count;
+}
+
+// ====================================================================================================================
+size_t PCMScan::FindEndAbove(const int16_t* samples, size_t count, uint16_t threshold)
+{
+	const int32_t limit = (threshold > INT16_MAX) ? INT16_MAX : int32_t(threshold);
+	const auto pos = _mm_set1_epi16(int16_t(limit));
+	const auto neg = _mm_set1_epi16(int16_t(-limit));
+
+	// 16 samples per iteration (backwards), then narrow down within the block
+	size_t i = count;
+	for (; i >= 16; i -= 16) {
+		const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + i - 16));
+		const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + i - 8));
+		if (AboveMask(a, pos, neg) | AboveMask(b, pos, neg)) {
+			break;
+		}
+	}
+	for (; i > 0; --i) {
+		if (IsAbove(samples[i - 1], limit)) {
+			return i;
+		}
+	}
+	return 0;
+}
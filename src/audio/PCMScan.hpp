@@ -0,0 +1,20 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include "../config.hpp"
+
+
+// Vectorized scans over interleaved 16-bit PCM samples
+class PCMScan final
+{
+public:
+	// Finds the index of the first sample with a magnitude above the threshold, or the count if there are none
+	static size_t FindFirstAbove(const int16_t* samples, size_t count, uint16_t threshold);
+	// Finds the index one past the last sample with a magnitude above the threshold, or zero if there are none
+	static size_t FindEndAbove(const int16_t* samples, size_t count, uint16_t threshold);
+}; // class PCMScan
@@ -0,0 +1,334 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#include "./SeekIndex.hpp"
+#include "./AudioFile.hpp"
+#include "../util/Hash.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+
+// Header for seek index cache files
+struct SeekIndexHeader final
+{
+public:
+	char magic[4];
+	uint32_t version;
+	uint32_t type;
+	uint32_t reserved;
+	uint64_t sourceSize;
+	uint64_t sourceHash;	// XXH64 of the source file contents
+	uint64_t pointCount;
+}; // struct SeekIndexHeader
+
+static constexpr char SEEK_INDEX_MAGIC[4]{ 'V', 'S', 'K', 'I' };
+static constexpr uint32_t SEEK_INDEX_VERSION{ 2 };
+
+
+// ====================================================================================================================
+SeekIndex::SeekIndex()
+	: type_{ AudioType::UNKNOWN }
+	, sourceSize_{ 0 }
+	, points_{ }
+{
+
+}
+
+// ====================================================================================================================
+SeekIndex::~SeekIndex()
+{
+
+}
+
+// ====================================================================================================================
+void SeekIndex::clear()
+{
+	type_ = AudioType::UNKNOWN;
+	sourceSize_ = 0;
+	points_.clear();
+}
+
+// ====================================================================================================================
+void SeekIndex::swap(SeekIndex& other)
+{
+	std::swap(type_, other.type_);
+	std::swap(sourceSize_, other.sourceSize_);
+	points_.swap(other.points_);
+}
+
+// ====================================================================================================================
+bool SeekIndex::save(const std::string& path, const uint8_t* data) const
+{
+	if (empty()) {
+		return false;
+	}
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file.is_open()) {
+		return false;
+	}
+
+	SeekIndexHeader header{ };
+	std::memcpy(header.magic, SEEK_INDEX_MAGIC, sizeof(SEEK_INDEX_MAGIC));
+	header.version = SEEK_INDEX_VERSION;
+	header.type = uint32_t(type_);
+	header.sourceSize = sourceSize_;
+	header.sourceHash = Hash::XXH64(data, size_t(sourceSize_));
+	header.pointCount = points_.size();
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(points_.data()), std::streamsize(points_.size() * sizeof(Point)));
+	return file.good();
+}
+
+// ====================================================================================================================
+bool SeekIndex::load(const std::string& path, AudioType type, const uint8_t* data, uint64_t size, uint64_t firstOffset)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file.is_open()) {
+		return false;
+	}
+
+	// Validate the header against the source file
+	SeekIndexHeader header{ };
+	if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+		return false;
+	}
+	if ((std::memcmp(header.magic, SEEK_INDEX_MAGIC, sizeof(SEEK_INDEX_MAGIC)) != 0) ||
+			(header.version != SEEK_INDEX_VERSION) || (header.type != uint32_t(type)) ||
+			(header.sourceSize != size) || (header.pointCount < 2) || (header.pointCount > (size + 1))) {
+		return false;
+	}
+
+	// Read the points
+	std::vector<Point> points(size_t(header.pointCount));
+	if (!file.read(reinterpret_cast<char*>(points.data()), std::streamsize(points.size() * sizeof(Point)))) {
+		return false;
+	}
+
+	// The points must be in stream order, and the frame points must cover the source data
+	uint64_t lastFrame = 0;
+	for (size_t i = 0; i < points.size(); ++i) {
+		const auto& point = points[i];
+		const uint64_t end = ((i + 1) == points.size()) ? size : (size - 1);
+		if ((point.offset < firstOffset) || (point.offset > end) ||
+				((i > 0) && (point.offset < points[i - 1].offset))) {
+			return false;
+		}
+		if (point.frame == NO_FRAME) {
+			if (type == AudioType::FLAC) {
+				return false;
+			}
+			continue;
+		}
+		if (point.frame < lastFrame) {
+			return false;
+		}
+		lastFrame = point.frame;
+	}
+
+	// Last, check that the index was built from the same contents
+	if (Hash::XXH64(data, size_t(size)) != header.sourceHash) {
+		return false;
+	}
+	type_ = type;
+	sourceSize_ = size;
+	points_.swap(points);
+	return true;
+}
+
+// ====================================================================================================================
+bool SeekIndex::buildVorbis(const uint8_t* data, uint64_t size)
+{
+	clear();
+
+	// Walk the page headers, skipping over the page payloads
+	uint64_t offset = 0;
+	uint32_t serial = 0;
+	std::vector<Point> points{ };
+	while ((offset + 27) <= size) {
+		const uint8_t* const header = data + offset;
+		if ((std::memcmp(header, "OggS", 4) != 0) || (header[4] != 0) || ((offset + 27 + header[26]) > size)) {
+			return false;
+		}
+
+		// Only single logical streams are supported by the decoder
+		uint32_t pageSerial;
+		std::memcpy(&pageSerial, header + 14, sizeof(pageSerial));
+		if (points.empty()) {
+			serial = pageSerial;
+		}
+		else if (pageSerial != serial) {
+			return false;
+		}
+
+		// Record the page
+		uint64_t granule;
+		std::memcpy(&granule, header + 6, sizeof(granule));
+		points.push_back({ (granule == UINT64_MAX) ? NO_FRAME : granule, offset });
+
+		// Move to the next page
+		uint64_t length = 0;
+		for (uint32_t i = 0; i < header[26]; ++i) {
+			length += header[27 + i];
+		}
+		offset += 27 + header[26] + length;
+		if (offset > size) {
+			return false;
+		}
+	}
+	if (points.empty()) {
+		return false;
+	}
+
+	// Terminate with the end of the stream
+	uint64_t lastFrame = 0;
+	for (auto it = points.rbegin(); it != points.rend(); ++it) {
+		if (it->frame != NO_FRAME) {
+			lastFrame = it->frame;
+			break;
+		}
+	}
+	points.push_back({ lastFrame, offset });
+
+	type_ = AudioType::VORBIS;
+	sourceSize_ = size;
+	points_.swap(points);
+	return true;
+}
+
+// ====================================================================================================================
+// Parses a FLAC frame header, returning the header length, or zero if there is not a valid header at the data
+static uint32_t ParseFlacFrameHeader(const uint8_t* data, uint64_t size, uint64_t* number, uint32_t* blockSize,
+	bool* variable)
+{
+	// Sync code, reserved bit, and reserved codes
+	if ((size < 6) || (data[0] != 0xFF) || ((data[1] & 0xFE) != 0xF8)) {
+		return 0;
+	}
+	const uint32_t blockCode = data[2] >> 4, rateCode = data[2] & 0x0F;
+	const uint32_t channelCode = data[3] >> 4, depthCode = (data[3] >> 1) & 0x07;
+	if ((blockCode == 0) || (rateCode == 0x0F) || (channelCode > 10) || (depthCode == 3) || (depthCode == 7) ||
+			(data[3] & 0x01)) {
+		return 0;
+	}
+	*variable = (data[1] & 0x01) != 0;
+
+	// UTF-8 style coded frame or sample number
+	uint32_t pos = 4;
+	uint32_t extra = 0;
+	uint64_t value = data[pos];
+	if ((value & 0x80) == 0) { extra = 0; }
+	else if ((value & 0xE0) == 0xC0) { extra = 1; value &= 0x1F; }
+	else if ((value & 0xF0) == 0xE0) { extra = 2; value &= 0x0F; }
+	else if ((value & 0xF8) == 0xF0) { extra = 3; value &= 0x07; }
+	else if ((value & 0xFC) == 0xF8) { extra = 4; value &= 0x03; }
+	else if ((value & 0xFE) == 0xFC) { extra = 5; value &= 0x01; }
+	else if (value == 0xFE) { extra = 6; value = 0; }
+	else { return 0; }
+	if ((pos + 1 + extra + 5) > size) {
+		return 0;
+	}
+	for (uint32_t i = 0; i < extra; ++i) {
+		const uint8_t b = data[pos + 1 + i];
+		if ((b & 0xC0) != 0x80) {
+			return 0;
+		}
+		value = (value << 6) | (b & 0x3F);
+	}
+	pos += 1 + extra;
+	*number = value;
+
+	// Block size
+	if (blockCode == 1) { *blockSize = 192; }
+	else if (blockCode <= 5) { *blockSize = 576u << (blockCode - 2); }
+	else if (blockCode == 6) { *blockSize = uint32_t(data[pos]) + 1; pos += 1; }
+	else if (blockCode == 7) { *blockSize = ((uint32_t(data[pos]) << 8) | data[pos + 1]) + 1; pos += 2; }
+	else { *blockSize = 256u << (blockCode - 8); }
+
+	// Sample rate
+	if (rateCode == 12) { pos += 1; }
+	else if ((rateCode == 13) || (rateCode == 14)) { pos += 2; }
+
+	// CRC-8 (polynomial 0x07) over the header
+	uint8_t crc = 0;
+	for (uint32_t i = 0; i < pos; ++i) {
+		crc ^= data[i];
+		for (uint32_t b = 0; b < 8; ++b) {
+			crc = uint8_t((crc & 0x80) ? ((crc << 1) ^ 0x07) : (crc << 1));
+		}
+	}
+	return (crc == data[pos]) ? (pos + 1) : 0;
+}
+
+// ====================================================================================================================
+bool SeekIndex::buildFlac(const uint8_t* data, uint64_t size)
+{
+	clear();
+
+	// Walk the metadata blocks to find the first frame, reading the stream info on the way
+	if ((size < 4) || (std::memcmp(data, "fLaC", 4) != 0)) {
+		return false;
+	}
+	uint64_t offset = 4;
+	uint32_t minFrameSize = 0;
+	uint64_t totalFrames = 0;
+	for (bool last = false; !last; ) {
+		if ((offset + 4) > size) {
+			return false;
+		}
+		last = (data[offset] & 0x80) != 0;
+		const uint32_t blockType = data[offset] & 0x7F;
+		const uint32_t length = (uint32_t(data[offset + 1]) << 16) | (uint32_t(data[offset + 2]) << 8) | data[offset + 3];
+		offset += 4;
+		if ((offset + length) > size) {
+			return false;
+		}
+		if ((blockType == 0) && (length >= 18)) {
+			const uint8_t* info = data + offset;
+			minFrameSize = (uint32_t(info[4]) << 16) | (uint32_t(info[5]) << 8) | info[6];
+			totalFrames = (uint64_t(info[13] & 0x0F) << 32) | (uint64_t(info[14]) << 24) | (uint64_t(info[15]) << 16) |
+				(uint64_t(info[16]) << 8) | info[17];
+		}
+		offset += length;
+	}
+
+	// Scan for frame headers, checking that each one continues the sequence of the previous frames
+	std::vector<Point> points{ };
+	uint64_t nextFrame = 0;
+	bool variable = false;
+	while ((offset < size) && ((totalFrames == 0) || (nextFrame < totalFrames))) {
+		uint64_t number;
+		uint32_t blockSize;
+		bool frameVariable;
+		const uint32_t length = ParseFlacFrameHeader(data + offset, size - offset, &number, &blockSize, &frameVariable);
+		if (length != 0) {
+			if (points.empty()) {
+				variable = frameVariable;
+			}
+			const uint64_t expected = variable ? nextFrame : uint64_t(points.size());
+			if ((frameVariable == variable) && (number == expected)) {
+				points.push_back({ nextFrame, offset });
+				nextFrame += blockSize;
+				offset += std::max<uint64_t>(length + 1, minFrameSize);
+				continue;
+			}
+		}
+		++offset;
+	}
+	if (points.empty() || ((totalFrames != 0) && (nextFrame != totalFrames))) {
+		return false;
+	}
+
+	// Terminate with the end of the stream
+	points.push_back({ nextFrame, size });
+
+	type_ = AudioType::FLAC;
+	sourceSize_ = size;
+	points_.swap(points);
+	return true;
+}
@@ -0,0 +1,62 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include "../config.hpp"
+
+#include <vector>
+
+enum class AudioType : uint32_t;
+
+
+// A compact table of (frame, byte offset) points that allows seeking in compressed audio without probing the file
+// The points partition the encoded stream in file order, and the final point marks the end of the stream data
+// The meaning of the points depends on the audio type:
+//   VORBIS - One point per Ogg page: the granule position of the page, and the file offset of the page
+//            Pages that do not finish a packet have a frame value of NO_FRAME
+//   FLAC   - One point per FLAC frame: the first PCM frame in the FLAC frame, and the file offset of the frame header
+class SeekIndex final
+{
+public:
+	// Frame value for points that do not have a known frame position
+	static constexpr uint64_t NO_FRAME = UINT64_MAX;
+
+	struct Point final
+	{
+	public:
+		uint64_t frame;
+		uint64_t offset;
+	}; // struct Point
+
+	SeekIndex();
+	~SeekIndex();
+
+	inline AudioType type() const { return type_; }
+	inline uint64_t sourceSize() const { return sourceSize_; }
+	inline const std::vector<Point>& points() const { return points_; }
+	inline bool empty() const { return points_.size() < 2; }
+
+	void clear();
+	void swap(SeekIndex& other);
+
+	// Persists the index to a cache file, or loads a cache file that matches the source type and contents
+	// The source contents are only hashed here, as building the index does not read all of the data. Loaded points must
+	// be in stream order, and inside of the source data from the first offset (the start of the first FLAC frame, or
+	// zero for Ogg/Vorbis) to the end of the source.
+	bool save(const std::string& path, const uint8_t* data) const;
+	bool load(const std::string& path, AudioType type, const uint8_t* data, uint64_t size, uint64_t firstOffset);
+
+	// Performs a scan of the pages in the contents of an Ogg/Vorbis file to build the index
+	bool buildVorbis(const uint8_t* data, uint64_t size);
+	// Performs a scan of the frame headers in the contents of a FLAC file to build the index
+	bool buildFlac(const uint8_t* data, uint64_t size);
+
+private:
+	AudioType type_;
+	uint64_t sourceSize_;
+	std::vector<Point> points_;
+}; // class SeekIndex
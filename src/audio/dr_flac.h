@@ -5936,8 +5936,10 @@ static drflac_bool32 drflac__seek_to_pcm_frame__seek_table(drflac* pFlac, drflac
 {
     drflac_uint32 iClosestSeekpoint = 0;
     drflac_bool32 isMidFrame = DRFLAC_FALSE;
+    drflac_bool32 isContained;
     drflac_uint64 runningPCMFrameCount;
-    drflac_uint32 iSeekpoint;
+    drflac_uint32 iSeekpointLo;
+    drflac_uint32 iSeekpointHi;
 
 
     DRFLAC_ASSERT(pFlac != NULL);
@@ -5946,12 +5948,20 @@ static drflac_bool32 drflac__seek_to_pcm_frame__seek_table(drflac* pFlac, drflac
         return DRFLAC_FALSE;
     }
 
-    for (iSeekpoint = 0; iSeekpoint < pFlac->seekpointCount; ++iSeekpoint) {
-        if (pFlac->pSeekpoints[iSeekpoint].firstPCMFrame >= pcmFrameIndex) {
-            break;
+    /* Seek points are sorted, so the closest one before the target can be found with a binary search. */
+    iSeekpointLo = 0;
+    iSeekpointHi = pFlac->seekpointCount;
+    while (iSeekpointLo < iSeekpointHi) {
+        drflac_uint32 iSeekpointMid = iSeekpointLo + ((iSeekpointHi - iSeekpointLo) / 2);
+        if (pFlac->pSeekpoints[iSeekpointMid].firstPCMFrame < pcmFrameIndex) {
+            iSeekpointLo = iSeekpointMid + 1;
+        } else {
+            iSeekpointHi = iSeekpointMid;
         }
-
-        iClosestSeekpoint = iSeekpoint;
+    }
+    iClosestSeekpoint = (iSeekpointLo > 0) ? (iSeekpointLo - 1) : 0;
+    if (iSeekpointLo < pFlac->seekpointCount && pFlac->pSeekpoints[iSeekpointLo].firstPCMFrame == pcmFrameIndex) {
+        iClosestSeekpoint = iSeekpointLo;   /* Exact match. */
     }
 
     /* There's been cases where the seek table contains only zeros. We need to do some basic validation on the closest seekpoint. */
@@ -5962,9 +5972,13 @@ static drflac_bool32 drflac__seek_to_pcm_frame__seek_table(drflac* pFlac, drflac
         return DRFLAC_FALSE;
     }
 
+    /* When the seek point lands on the FLAC frame holding the target (always the case for dense seek tables) it can be decoded directly. */
+    isContained = pFlac->pSeekpoints[iClosestSeekpoint].firstPCMFrame <= pcmFrameIndex &&
+        (pcmFrameIndex - pFlac->pSeekpoints[iClosestSeekpoint].firstPCMFrame) < pFlac->pSeekpoints[iClosestSeekpoint].pcmFrameCount;
+
 #if !defined(DR_FLAC_NO_CRC)
     /* At this point we should know the closest seek point. We can use a binary search for this. We need to know the total sample count for this. */
-    if (pFlac->totalPCMFrameCount > 0) {
+    if (pFlac->totalPCMFrameCount > 0 && !isContained) {
         drflac_uint64 byteRangeLo;
         drflac_uint64 byteRangeHi;
 
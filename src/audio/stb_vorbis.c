@@ -261,6 +261,16 @@ extern stb_vorbis * stb_vorbis_open_memory(const unsigned char *data, int len,
 // create an ogg vorbis decoder from an ogg vorbis stream in memory (note
 // this must be the entire stream!). on failure, returns NULL and sets *error
 
+extern stb_vorbis * stb_vorbis_open_shared(stb_vorbis *source,
+                                  int *error, const stb_vorbis_alloc *alloc_buffer);
+// create a second decoder for a stream already opened with stb_vorbis_open_memory(),
+// positioned at the start of the stream. the new decoder shares the memory
+// buffer and the setup tables (codebooks, floors, residues, mappings, and
+// transform tables) of the source, and only allocates its own decode buffers.
+// the source must not be closed before any decoders opened from it. fails with
+// VORBIS_invalid_api_mixing if the source does not support sharing (it was not
+// opened from memory, or the first audio packet shares a page with the headers)
+
 #ifndef STB_VORBIS_NO_STDIO
 extern stb_vorbis * stb_vorbis_open_filename(const char *filename,
                                   int *error, const stb_vorbis_alloc *alloc_buffer);
@@ -298,6 +308,19 @@ extern int stb_vorbis_seek(stb_vorbis *f, unsigned int sample_number);
 extern int stb_vorbis_seek_start(stb_vorbis *f);
 // this function is equivalent to stb_vorbis_seek(f,0)
 
+typedef struct
+{
+   unsigned int page_start, page_end;
+   unsigned int last_decoded_sample;
+} stb_vorbis_page_info;
+
+extern void stb_vorbis_set_page_index(stb_vorbis *f, const stb_vorbis_page_info *pages, int count);
+// provide a table of the Ogg pages in the stream, sorted by file offset, that
+// have a known 'last_decoded_sample' (granule position). seeking will then find
+// the pages bracketing the target with a binary search over the table, instead
+// of probing the file. the table is not copied, and must stay valid until it is
+// replaced or the decoder is closed. pass NULL to go back to probing the file.
+
 extern unsigned int stb_vorbis_stream_length_in_samples(stb_vorbis *f);
 extern float        stb_vorbis_stream_length_in_seconds(stb_vorbis *f);
 // these functions return the total length of the vorbis stream
@@ -589,6 +612,14 @@ enum STBVorbisError
    #define realloc(s)  0
 #endif // STB_VORBIS_NO_CRT
 
+// heap hook, so the library can check that decoding does not touch the heap
+#ifdef VEGA_REALTIME_CHECKS
+   extern void vega_realtime_check_heap(void);
+   #define STB_VORBIS_HEAP_CHECK()  vega_realtime_check_heap()
+#else
+   #define STB_VORBIS_HEAP_CHECK()  ((void) 0)
+#endif
+
 #include <limits.h>
 
 #ifdef __MINGW32__
@@ -883,6 +914,14 @@ struct stb_vorbis
   // sample-access
    int channel_buffer_start;
    int channel_buffer_end;
+
+  // optional caller-provided seek table
+   const stb_vorbis_page_info *page_index;
+   int page_index_count;
+
+  // setup sharing
+   int longest_floorlist;
+   int shared_setup; // setup tables are owned by another decoder
 };
 
 #if defined(STB_VORBIS_NO_PUSHDATA_API)
@@ -942,12 +981,14 @@ static void *setup_malloc(vorb *f, int sz)
       f->setup_offset += sz;
       return p;
    }
+   STB_VORBIS_HEAP_CHECK();
    return sz ? malloc(sz) : NULL;
 }
 
 static void setup_free(vorb *f, void *p)
 {
    if (f->alloc.alloc_buffer) return; // do nothing; setup mem is a stack
+   if (p) STB_VORBIS_HEAP_CHECK();
    free(p);
 }
 
@@ -959,6 +1000,7 @@ static void *setup_temp_malloc(vorb *f, int sz)
       f->temp_offset -= sz;
       return (char *) f->alloc.alloc_buffer + f->temp_offset;
    }
+   STB_VORBIS_HEAP_CHECK();
    return malloc(sz);
 }
 
@@ -968,6 +1010,7 @@ static void setup_temp_free(vorb *f, void *p, int sz)
       f->temp_offset += (sz+7)&~7;
       return;
    }
+   if (p) STB_VORBIS_HEAP_CHECK();
    free(p);
 }
 
@@ -4108,6 +4151,7 @@ static int start_decoder(vorb *f)
    flush_packet(f);
 
    f->previous_length = 0;
+   f->longest_floorlist = longest_floorlist;
 
    for (i=0; i < f->channels; ++i) {
       f->channel_buffers[i] = (float *) setup_malloc(f, sizeof(float) * f->blocksize_1);
@@ -4196,6 +4240,19 @@ static void vorbis_deinit(stb_vorbis *p)
    }
    setup_free(p, p->comment_list);
 
+   if (p->shared_setup) {
+      // only the decode buffers belong to this decoder
+      for (i=0; i < p->channels && i < STB_VORBIS_MAX_CHANNELS; ++i) {
+         setup_free(p, p->channel_buffers[i]);
+         setup_free(p, p->previous_window[i]);
+         #ifdef STB_VORBIS_NO_DEFER_FLOOR
+         setup_free(p, p->floor_buffers[i]);
+         #endif
+         setup_free(p, p->finalY[i]);
+      }
+      return;
+   }
+
    if (p->residue_config) {
       for (i=0; i < p->residue_count; ++i) {
          Residue *r = p->residue_config+i;
@@ -4719,6 +4776,29 @@ static int seek_to_sample_coarse(stb_vorbis *f, uint32 sample_number)
       return 0;
    }
 
+   if (f->page_index) {
+      // find the first indexed page past the limit, and tighten the bounds around it
+      int lo = 0, hi = f->page_index_count;
+      while (lo < hi) {
+         int m = (lo + hi) >> 1;
+         if (f->page_index[m].last_decoded_sample <= last_sample_limit)
+            lo = m + 1;
+         else
+            hi = m;
+      }
+      if (lo > 0 && f->page_index[lo-1].page_start > left.page_start) {
+         left.page_start = f->page_index[lo-1].page_start;
+         left.page_end = f->page_index[lo-1].page_end;
+         left.last_decoded_sample = f->page_index[lo-1].last_decoded_sample;
+      }
+      if (lo < f->page_index_count && f->page_index[lo].page_start < right.page_start &&
+            f->page_index[lo].page_start >= left.page_end) {
+         right.page_start = f->page_index[lo].page_start;
+         right.page_end = f->page_index[lo].page_end;
+         right.last_decoded_sample = f->page_index[lo].last_decoded_sample;
+      }
+   }
+
    while (left.page_end != right.page_start) {
       assert(left.page_end < right.page_start);
       // search range in bytes
@@ -4913,6 +4993,12 @@ int stb_vorbis_seek(stb_vorbis *f, unsigned int sample_number)
    return 1;
 }
 
+void stb_vorbis_set_page_index(stb_vorbis *f, const stb_vorbis_page_info *pages, int count)
+{
+   f->page_index = (pages && count > 0) ? pages : NULL;
+   f->page_index_count = f->page_index ? count : 0;
+}
+
 int stb_vorbis_seek_start(stb_vorbis *f)
 {
    if (IS_PUSH_MODE(f)) { return error(f, VORBIS_invalid_api_mixing); }
@@ -5100,6 +5186,92 @@ stb_vorbis * stb_vorbis_open_memory(const unsigned char *data, int len, int *err
    return NULL;
 }
 
+stb_vorbis * stb_vorbis_open_shared(stb_vorbis *source, int *error, const stb_vorbis_alloc *alloc)
+{
+   stb_vorbis *f, p;
+   int i;
+   if (source == NULL || IS_PUSH_MODE(source) || !USE_MEMORY(source) || source->first_audio_page_offset == 0) {
+      if (error) *error = VORBIS_invalid_api_mixing;
+      return NULL;
+   }
+   vorbis_init(&p, alloc);
+   p.stream = source->stream_start;
+   p.stream_end = source->stream_end;
+   p.stream_start = source->stream_start;
+   p.stream_len = source->stream_len;
+   p.push_mode = FALSE;
+
+   // copy the stream information and setup tables
+   p.sample_rate = source->sample_rate;
+   p.channels = source->channels;
+   p.setup_memory_required = source->setup_memory_required;
+   p.temp_memory_required = source->temp_memory_required;
+   p.setup_temp_memory_required = source->setup_temp_memory_required;
+   p.first_audio_page_offset = source->first_audio_page_offset;
+   p.p_first = source->p_first;
+   p.p_last = source->p_last;
+   p.total_samples = source->total_samples;
+   p.blocksize[0] = source->blocksize[0];
+   p.blocksize[1] = source->blocksize[1];
+   p.blocksize_0 = source->blocksize_0;
+   p.blocksize_1 = source->blocksize_1;
+   p.codebook_count = source->codebook_count;
+   p.codebooks = source->codebooks;
+   p.floor_count = source->floor_count;
+   memcpy(p.floor_types, source->floor_types, sizeof(p.floor_types));
+   p.floor_config = source->floor_config;
+   p.residue_count = source->residue_count;
+   memcpy(p.residue_types, source->residue_types, sizeof(p.residue_types));
+   p.residue_config = source->residue_config;
+   p.mapping_count = source->mapping_count;
+   p.mapping = source->mapping;
+   p.mode_count = source->mode_count;
+   memcpy(p.mode_config, source->mode_config, sizeof(p.mode_config));
+   for (i=0; i < 2; ++i) {
+      p.A[i] = source->A[i];
+      p.B[i] = source->B[i];
+      p.C[i] = source->C[i];
+      p.window[i] = source->window[i];
+      p.bit_reverse[i] = source->bit_reverse[i];
+   }
+   p.longest_floorlist = source->longest_floorlist;
+   p.shared_setup = TRUE;
+
+   // allocate the decode buffers
+   for (i=0; i < p.channels; ++i) {
+      p.channel_buffers[i] = (float *) setup_malloc(&p, sizeof(float) * p.blocksize_1);
+      p.previous_window[i] = (float *) setup_malloc(&p, sizeof(float) * p.blocksize_1/2);
+      p.finalY[i]          = (int16 *) setup_malloc(&p, sizeof(int16) * p.longest_floorlist);
+      if (p.channel_buffers[i] == NULL || p.previous_window[i] == NULL || p.finalY[i] == NULL) goto fail;
+      memset(p.channel_buffers[i], 0, sizeof(float) * p.blocksize_1);
+      #ifdef STB_VORBIS_NO_DEFER_FLOOR
+      p.floor_buffers[i]   = (float *) setup_malloc(&p, sizeof(float) * p.blocksize_1/2);
+      if (p.floor_buffers[i] == NULL) goto fail;
+      #endif
+   }
+   if (p.alloc.alloc_buffer) {
+      if (p.setup_offset + sizeof(p) + p.temp_memory_required > (unsigned) p.temp_offset)
+         goto fail;
+   }
+
+   f = vorbis_alloc(&p);
+   if (f) {
+      *f = p;
+      if (stb_vorbis_seek_start(f)) {
+         if (error) *error = VORBIS__no_error;
+         return f;
+      }
+      if (error) *error = f->error;
+      stb_vorbis_close(f);
+      return NULL;
+   }
+
+fail:
+   if (error) *error = VORBIS_outofmem;
+   vorbis_deinit(&p);
+   return NULL;
+}
+
 #ifndef STB_VORBIS_NO_INTEGER_CONVERSION
 #define PLAYBACK_MONO     1
 #define PLAYBACK_LEFT     2
@@ -0,0 +1,481 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#include "./BlockCompress.hpp"
+
+#include "../util/ThreadPool.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#include <emmintrin.h>
+
+
+// The interpolation weight of each index of the formats, used for the least squares endpoint fits
+static constexpr float BC1_WEIGHTS[4]{ 0.0f, 1.0f, 1.0f / 3, 2.0f / 3 };
+static constexpr uint32_t BC7_WEIGHTS[16]{ 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+static constexpr float BC7_FIT_WEIGHTS[16]{
+	0.0f, 0.0625f, 0.140625f, 0.203125f, 0.265625f, 0.328125f, 0.40625f, 0.46875f,
+	0.53125f, 0.59375f, 0.671875f, 0.734375f, 0.796875f, 0.859375f, 0.9375f, 1.0f
+};
+// The power iterations used to find the principal axis of a block
+static constexpr uint32_t AXIS_ITERATIONS{ 8 };
+
+// The pixels of a 4x4 block, stored by channel
+struct Block final
+{
+public:
+	alignas(16) float channels[4][16];
+}; // struct Block
+
+// A mode 6 BC7 block
+struct Bc7Block final
+{
+public:
+	int32_t endpoints[2][4];	// 7-bit endpoints
+	int32_t pbits[2];
+	uint8_t indices[16];
+	float error;
+}; // struct Bc7Block
+
+// Writes the bits of a 16-byte block, from the lowest bit
+struct BitWriter final
+{
+public:
+	uint8_t* out;
+	uint32_t position;
+
+	inline void write(uint32_t value, uint32_t bits) {
+		for (uint32_t bi = 0; bi < bits; ++bi, ++position) {
+			out[position >> 3] |= uint8_t(((value >> bi) & 1) << (position & 7));
+		}
+	}
+}; // struct BitWriter
+
+
+// ====================================================================================================================
+static void GatherBlock(const uint8_t* src, uint32_t width, uint32_t height, uint32_t bx, uint32_t by, Block* block)
+{
+	// Blocks past the edges of the level repeat the edge pixels
+	for (uint32_t y = 0; y < 4; ++y) {
+		const uint32_t sy = std::min((by * 4) + y, height - 1);
+		for (uint32_t x = 0; x < 4; ++x) {
+			const uint32_t sx = std::min((bx * 4) + x, width - 1);
+			const uint8_t* const pixel = src + ((size_t(sy) * width + sx) * 4);
+			for (uint32_t ch = 0; ch < 4; ++ch) {
+				block->channels[ch][(y * 4) + x] = pixel[ch];
+			}
+		}
+	}
+}
+
+// ====================================================================================================================
+// Selects the nearest palette entry for each pixel with the weighted squared distance, and returns the total error
+static float SelectIndices(const Block& block, const float (*palette)[4], uint32_t count, const float* weights,
+	uint8_t* indices)
+{
+	const __m128 w[4]{
+		_mm_set1_ps(weights[0]), _mm_set1_ps(weights[1]), _mm_set1_ps(weights[2]), _mm_set1_ps(weights[3])
+	};
+	__m128 total = _mm_setzero_ps();
+	for (uint32_t gi = 0; gi < 16; gi += 4) {
+		const __m128 px[4]{
+			_mm_load_ps(block.channels[0] + gi), _mm_load_ps(block.channels[1] + gi),
+			_mm_load_ps(block.channels[2] + gi), _mm_load_ps(block.channels[3] + gi)
+		};
+		__m128 best = _mm_set1_ps(FLT_MAX);
+		__m128i bestIndex = _mm_setzero_si128();
+		for (uint32_t ei = 0; ei < count; ++ei) {
+			__m128 dist = _mm_setzero_ps();
+			for (uint32_t ch = 0; ch < 4; ++ch) {
+				const __m128 diff = _mm_sub_ps(px[ch], _mm_set1_ps(palette[ei][ch]));
+				dist = _mm_add_ps(dist, _mm_mul_ps(w[ch], _mm_mul_ps(diff, diff)));
+			}
+			const __m128i closer = _mm_castps_si128(_mm_cmplt_ps(dist, best));
+			best = _mm_min_ps(best, dist);
+			bestIndex = _mm_or_si128(_mm_and_si128(closer, _mm_set1_epi32(int32_t(ei))),
+				_mm_andnot_si128(closer, bestIndex));
+		}
+		total = _mm_add_ps(total, best);
+		alignas(16) int32_t selected[4];
+		_mm_store_si128(reinterpret_cast<__m128i*>(selected), bestIndex);
+		for (uint32_t pi = 0; pi < 4; ++pi) {
+			indices[gi + pi] = uint8_t(selected[pi]);
+		}
+	}
+	alignas(16) float sums[4];
+	_mm_store_ps(sums, total);
+	return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+}
+
+// ====================================================================================================================
+// Finds the endpoints at the extents of the block along the principal axis of the channels
+static void AxisEndpoints(const Block& block, uint32_t channels, float* e0, float* e1)
+{
+	float mean[4]{ }, cov[4][4]{ };
+	for (uint32_t ch = 0; ch < channels; ++ch) {
+		for (uint32_t pi = 0; pi < 16; ++pi) {
+			mean[ch] += block.channels[ch][pi];
+		}
+		mean[ch] /= 16;
+	}
+	for (uint32_t pi = 0; pi < 16; ++pi) {
+		for (uint32_t c0 = 0; c0 < channels; ++c0) {
+			for (uint32_t c1 = c0; c1 < channels; ++c1) {
+				cov[c0][c1] += (block.channels[c0][pi] - mean[c0]) * (block.channels[c1][pi] - mean[c1]);
+			}
+		}
+	}
+	for (uint32_t c0 = 0; c0 < channels; ++c0) {
+		for (uint32_t c1 = 0; c1 < c0; ++c1) {
+			cov[c0][c1] = cov[c1][c0];
+		}
+	}
+
+	// Power iteration from the covariance row of the channel with the largest variance, which always has a component
+	// along the principal axis (starting from the diagonal fails for channels that vary in opposite directions)
+	uint32_t largest = 0;
+	for (uint32_t ch = 1; ch < channels; ++ch) {
+		largest = (cov[ch][ch] > cov[largest][largest]) ? ch : largest;
+	}
+	float axis[4]{ };
+	for (uint32_t ch = 0; ch < channels; ++ch) {
+		axis[ch] = cov[largest][ch];
+	}
+	for (uint32_t ii = 0; ii < AXIS_ITERATIONS; ++ii) {
+		float next[4]{ }, length = 0;
+		for (uint32_t c0 = 0; c0 < channels; ++c0) {
+			for (uint32_t c1 = 0; c1 < channels; ++c1) {
+				next[c0] += cov[c0][c1] * axis[c1];
+			}
+			length = std::max(length, std::abs(next[c0]));
+		}
+		if (length < 1e-6f) {
+			break;
+		}
+		for (uint32_t ch = 0; ch < channels; ++ch) {
+			axis[ch] = next[ch] / length;
+		}
+	}
+	float length = 0;
+	for (uint32_t ch = 0; ch < channels; ++ch) {
+		length += axis[ch] * axis[ch];
+	}
+
+	// Fall back to the diagonal of the bounding box if the iteration collapsed
+	if (length < 1e-6f) {
+		length = 0;
+		for (uint32_t ch = 0; ch < channels; ++ch) {
+			const float* const values = block.channels[ch];
+			axis[ch] = *std::max_element(values, values + 16) - *std::min_element(values, values + 16);
+			length += axis[ch] * axis[ch];
+		}
+	}
+	length = std::sqrt(length);
+	for (uint32_t ch = 0; ch < channels; ++ch) {
+		axis[ch] = (length > 1e-6f) ? (axis[ch] / length) : 0.0f;
+	}
+
+	// Project onto the axis
+	float minProj = FLT_MAX, maxProj = -FLT_MAX;
+	for (uint32_t pi = 0; pi < 16; ++pi) {
+		float proj = 0;
+		for (uint32_t ch = 0; ch < channels; ++ch) {
+			proj += (block.channels[ch][pi] - mean[ch]) * axis[ch];
+		}
+		minProj = std::min(minProj, proj);
+		maxProj = std::max(maxProj, proj);
+	}
+	for (uint32_t ch = 0; ch < channels; ++ch) {
+		e0[ch] = std::min(std::max(mean[ch] + (axis[ch] * maxProj), 0.0f), 255.0f);
+		e1[ch] = std::min(std::max(mean[ch] + (axis[ch] * minProj), 0.0f), 255.0f);
+	}
+}
+
+// ====================================================================================================================
+// Solves for the endpoints that best fit the block with the weights of the selected indices, false if degenerate
+static bool FitEndpoints(const Block& block, const uint8_t* indices, const float* weights, uint32_t channels,
+	float* e0, float* e1)
+{
+	float aa = 0, ab = 0, bb = 0, ax[4]{ }, bx[4]{ };
+	for (uint32_t pi = 0; pi < 16; ++pi) {
+		const float t = weights[indices[pi]], s = 1 - t;
+		aa += s * s;
+		ab += s * t;
+		bb += t * t;
+		for (uint32_t ch = 0; ch < channels; ++ch) {
+			ax[ch] += s * block.channels[ch][pi];
+			bx[ch] += t * block.channels[ch][pi];
+		}
+	}
+	const float det = (aa * bb) - (ab * ab);
+	if (std::abs(det) < 1e-6f) {
+		return false;
+	}
+	for (uint32_t ch = 0; ch < channels; ++ch) {
+		e0[ch] = std::min(std::max(((bb * ax[ch]) - (ab * bx[ch])) / det, 0.0f), 255.0f);
+		e1[ch] = std::min(std::max(((aa * bx[ch]) - (ab * ax[ch])) / det, 0.0f), 255.0f);
+	}
+	return true;
+}
+
+// ====================================================================================================================
+static inline uint16_t Pack565(const float* color)
+{
+	const uint32_t r = uint32_t((color[0] * (31 / 255.0f)) + 0.5f);
+	const uint32_t g = uint32_t((color[1] * (63 / 255.0f)) + 0.5f);
+	const uint32_t b = uint32_t((color[2] * (31 / 255.0f)) + 0.5f);
+	return uint16_t((r << 11) | (g << 5) | b);
+}
+
+// ====================================================================================================================
+static inline void Unpack565(uint16_t packed, float* color)
+{
+	const uint32_t r = (packed >> 11) & 0x1F, g = (packed >> 5) & 0x3F, b = packed & 0x1F;
+	color[0] = float((r << 3) | (r >> 2));
+	color[1] = float((g << 2) | (g >> 4));
+	color[2] = float((b << 3) | (b >> 2));
+	color[3] = 0;
+}
+
+// ====================================================================================================================
+static float SelectBC1(const Block& block, uint16_t c0, uint16_t c1, uint8_t* indices)
+{
+	static constexpr float WEIGHTS[4]{ 1, 1, 1, 0 };
+	float palette[4][4];
+	Unpack565(c0, palette[0]);
+	Unpack565(c1, palette[1]);
+	for (uint32_t ch = 0; ch < 4; ++ch) {
+		palette[2][ch] = ((2 * palette[0][ch]) + palette[1][ch]) / 3;
+		palette[3][ch] = (palette[0][ch] + (2 * palette[1][ch])) / 3;
+	}
+	return SelectIndices(block, palette, 4, WEIGHTS, indices);
+}
+
+// ====================================================================================================================
+// Encodes the color as an opaque BC1 block, which is also the color part of BC3 blocks
+static void EncodeBC1(const Block& block, uint8_t* out)
+{
+	float e0[4], e1[4];
+	AxisEndpoints(block, 3, e0, e1);
+	uint16_t c0 = Pack565(e0), c1 = Pack565(e1);
+	uint8_t indices[16];
+	const float error = SelectBC1(block, c0, c1, indices);
+
+	// One refinement pass, which is usually enough for the coarse BC1 palette
+	if (FitEndpoints(block, indices, BC1_WEIGHTS, 3, e0, e1)) {
+		const uint16_t r0 = Pack565(e0), r1 = Pack565(e1);
+		uint8_t refined[16];
+		if (SelectBC1(block, r0, r1, refined) < error) {
+			c0 = r0;
+			c1 = r1;
+			std::memcpy(indices, refined, 16);
+		}
+	}
+
+	// The first endpoint must be larger to select the four color mode
+	uint32_t bits = 0;
+	if (c0 < c1) {
+		std::swap(c0, c1);
+		for (auto& index : indices) {
+			index ^= 1;
+		}
+	}
+	if (c0 != c1) {
+		for (uint32_t pi = 0; pi < 16; ++pi) {
+			bits |= uint32_t(indices[pi]) << (2 * pi);
+		}
+	}
+	out[0] = uint8_t(c0);
+	out[1] = uint8_t(c0 >> 8);
+	out[2] = uint8_t(c1);
+	out[3] = uint8_t(c1 >> 8);
+	std::memcpy(out + 4, &bits, 4);
+}
+
+// ====================================================================================================================
+// Encodes one channel as a BC4 block, which is also the alpha part of BC3 blocks and each half of BC5 blocks
+static void EncodeBC4(const Block& block, uint32_t channel, uint8_t* out)
+{
+	const float* const values = block.channels[channel];
+	const float maxValue = *std::max_element(values, values + 16);
+	const float minValue = *std::min_element(values, values + 16);
+	const uint32_t a0 = uint32_t(maxValue), a1 = uint32_t(minValue);
+	std::memset(out, 0, 8);
+	out[0] = uint8_t(a0);
+	out[1] = uint8_t(a1);
+	if (a0 == a1) {
+		return;
+	}
+
+	// Eight value mode, with the interpolated values between the endpoints
+	float weights[4]{ }, palette[8][4]{ };
+	weights[channel] = 1;
+	palette[0][channel] = float(a0);
+	palette[1][channel] = float(a1);
+	for (uint32_t ei = 2; ei < 8; ++ei) {
+		palette[ei][channel] = float(((8 - ei) * a0) + ((ei - 1) * a1)) / 7;
+	}
+	uint8_t indices[16];
+	SelectIndices(block, palette, 8, weights, indices);
+	uint64_t bits = 0;
+	for (uint32_t pi = 0; pi < 16; ++pi) {
+		bits |= uint64_t(indices[pi]) << (3 * pi);
+	}
+	for (uint32_t bi = 0; bi < 6; ++bi) {
+		out[2 + bi] = uint8_t(bits >> (8 * bi));
+	}
+}
+
+// ====================================================================================================================
+// Quantizes the endpoints with the parity bits, and keeps the block if it has less error than the best block
+static void TryBC7(const Block& block, const float* e0, const float* e1, bool allPbits, Bc7Block* best)
+{
+	static constexpr float CHANNEL_WEIGHTS[4]{ 1, 1, 1, 1 };
+	const float* const endpoints[2]{ e0, e1 };
+
+	// The quantized endpoints for each parity bit, and the error of each
+	int32_t quantized[2][2][4];
+	float quantError[2][2]{ };
+	for (uint32_t ei = 0; ei < 2; ++ei) {
+		for (int32_t pbit = 0; pbit < 2; ++pbit) {
+			for (uint32_t ch = 0; ch < 4; ++ch) {
+				const int32_t value = int32_t(((endpoints[ei][ch] - pbit) * 0.5f) + 0.5f);
+				quantized[ei][pbit][ch] = std::min(std::max(value, 0), 127);
+				const float diff = float((quantized[ei][pbit][ch] << 1) | pbit) - endpoints[ei][ch];
+				quantError[ei][pbit] += diff * diff;
+			}
+		}
+	}
+
+	// Without testing every combination, each endpoint uses the parity bit with the least quantization error
+	const int32_t bestP0 = (quantError[0][1] < quantError[0][0]) ? 1 : 0;
+	const int32_t bestP1 = (quantError[1][1] < quantError[1][0]) ? 1 : 0;
+	for (int32_t p0 = 0; p0 < 2; ++p0) {
+		for (int32_t p1 = 0; p1 < 2; ++p1) {
+			if (!allPbits && ((p0 != bestP0) || (p1 != bestP1))) {
+				continue;
+			}
+			float palette[16][4];
+			for (uint32_t ch = 0; ch < 4; ++ch) {
+				const uint32_t a = uint32_t((quantized[0][p0][ch] << 1) | p0);
+				const uint32_t b = uint32_t((quantized[1][p1][ch] << 1) | p1);
+				for (uint32_t ei = 0; ei < 16; ++ei) {
+					palette[ei][ch] = float(((64 - BC7_WEIGHTS[ei]) * a + (BC7_WEIGHTS[ei] * b) + 32) >> 6);
+				}
+			}
+			uint8_t indices[16];
+			const float error = SelectIndices(block, palette, 16, CHANNEL_WEIGHTS, indices);
+			if (error < best->error) {
+				std::memcpy(best->endpoints[0], quantized[0][p0], sizeof(best->endpoints[0]));
+				std::memcpy(best->endpoints[1], quantized[1][p1], sizeof(best->endpoints[1]));
+				best->pbits[0] = p0;
+				best->pbits[1] = p1;
+				std::memcpy(best->indices, indices, 16);
+				best->error = error;
+			}
+		}
+	}
+}
+
+// ====================================================================================================================
+// Encodes the block as a mode 6 BC7 block (RGBA 7.7.7.7 endpoints with unique parity bits, and 4-bit indices)
+// Quality adds least squares refinement passes, and from 2 also tests every parity bit combination.
+static void EncodeBC7(const Block& block, uint32_t quality, uint8_t* out)
+{
+	float e0[4], e1[4];
+	AxisEndpoints(block, 4, e0, e1);
+	Bc7Block best{ };
+	best.error = FLT_MAX;
+	const bool allPbits = quality >= 2;
+	TryBC7(block, e0, e1, allPbits, &best);
+	for (uint32_t pass = 0; (pass < quality) && (best.error > 0); ++pass) {
+		const float last = best.error;
+		if (!FitEndpoints(block, best.indices, BC7_FIT_WEIGHTS, 4, e0, e1)) {
+			break;
+		}
+		TryBC7(block, e0, e1, allPbits, &best);
+		if (best.error >= last) {
+			break;
+		}
+	}
+
+	// The anchor index (first pixel) has an implicit zero high bit
+	if (best.indices[0] >= 8) {
+		std::swap(best.endpoints[0], best.endpoints[1]);
+		std::swap(best.pbits[0], best.pbits[1]);
+		for (auto& index : best.indices) {
+			index = uint8_t(15 - index);
+		}
+	}
+	std::memset(out, 0, 16);
+	BitWriter writer{ out, 0 };
+	writer.write(1 << 6, 7);
+	for (uint32_t ch = 0; ch < 4; ++ch) {
+		writer.write(uint32_t(best.endpoints[0][ch]), 7);
+		writer.write(uint32_t(best.endpoints[1][ch]), 7);
+	}
+	writer.write(uint32_t(best.pbits[0]), 1);
+	writer.write(uint32_t(best.pbits[1]), 1);
+	writer.write(best.indices[0], 3);
+	for (uint32_t pi = 1; pi < 16; ++pi) {
+		writer.write(best.indices[pi], 4);
+	}
+}
+
+// ====================================================================================================================
+uint32_t BlockCompress::BlockSize(TextureFormat format)
+{
+	switch (format) {
+		case TextureFormat::RGBA8: return 4;
+		case TextureFormat::BC1:
+		case TextureFormat::BC4: return 8;
+		case TextureFormat::BC3:
+		case TextureFormat::BC5:
+		case TextureFormat::BC7: return 16;
+		default: return 0;
+	}
+}
+
+// ====================================================================================================================
+size_t BlockCompress::LevelSize(TextureFormat format, uint32_t width, uint32_t height)
+{
+	if (format == TextureFormat::RGBA8) {
+		return size_t(width) * height * 4;
+	}
+	return size_t((width + 3) / 4) * ((height + 3) / 4) * BlockSize(format);
+}
+
+// ====================================================================================================================
+void BlockCompress::Compress(const uint8_t* src, uint32_t width, uint32_t height, TextureFormat format,
+	uint32_t quality, uint8_t* dst)
+{
+	if (format == TextureFormat::RGBA8) {
+		std::memcpy(dst, src, LevelSize(format, width, height));
+		return;
+	}
+
+	const uint32_t blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+	const uint32_t blockSize = BlockSize(format);
+	quality = std::min(quality, uint32_t(ImageCompressOptions::MAX_QUALITY));
+	ThreadPool::Shared().parallelFor(blocksY, [=](size_t by) {
+		uint8_t* out = dst + (by * blocksX * blockSize);
+		Block block;
+		for (uint32_t bx = 0; bx < blocksX; ++bx, out += blockSize) {
+			GatherBlock(src, width, height, bx, uint32_t(by), &block);
+			switch (format) {
+				case TextureFormat::BC1: EncodeBC1(block, out); break;
+				case TextureFormat::BC3: EncodeBC4(block, 3, out); EncodeBC1(block, out + 8); break;
+				case TextureFormat::BC4: EncodeBC4(block, 0, out); break;
+				case TextureFormat::BC5: EncodeBC4(block, 0, out); EncodeBC4(block, 1, out + 8); break;
+				case TextureFormat::BC7: EncodeBC7(block, quality, out); break;
+				default: break;
+			}
+		}
+	});
+}
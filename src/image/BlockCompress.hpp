@@ -0,0 +1,53 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include "../config.hpp"
+#include "./MipGenerator.hpp"
+
+
+// The texture data formats produced by compression
+enum class TextureFormat : uint32_t
+{
+	UNKNOWN = 0,	// Special unknown format signifying an error or unsupported data
+	RGBA8 = 1,		// Uncompressed 8-bit RGBA
+	BC1 = 2,		// RGB in 8-byte blocks (alpha is ignored)
+	BC3 = 3,		// RGBA in 16-byte blocks, with BC1 color and BC4 alpha
+	BC4 = 4,		// Single channel (red) in 8-byte blocks
+	BC5 = 5,		// Two channels (red and green) in 16-byte blocks
+	BC7 = 6,		// RGBA in 16-byte blocks (encoded with mode 6)
+}; // enum class TextureFormat
+
+
+// Options for compressing image data into texture data
+struct ImageCompressOptions final
+{
+public:
+	static constexpr uint32_t MAX_QUALITY{ 4 };
+
+	TextureFormat format;
+	uint32_t quality;				// BC7 endpoint search effort, from 0 (fastest) to MAX_QUALITY
+	VegaBool mipmaps;				// If the full mipmap chain is generated and compressed
+	ImageMipOptions mipOptions;		// The options for the mipmap chain, if generated
+}; // struct ImageCompressOptions
+
+
+// Encodes 8-bit RGBA data into block compressed formats
+// Each 4x4 block is fit with endpoints along the principal axis of its colors, then the indices are selected with SSE
+// kernels that test every palette entry for four pixels at once, and the endpoints are refined with least squares
+// fits to the selected indices. Levels are split into rows of blocks that are encoded on the shared thread pool.
+class BlockCompress final
+{
+public:
+	// The size of one 4x4 block of the format, or of one pixel for uncompressed formats
+	static uint32_t BlockSize(TextureFormat format);
+	// The size of a level of the format
+	static size_t LevelSize(TextureFormat format, uint32_t width, uint32_t height);
+	// Encodes a level of RGBA data into dst, which must have the size given by LevelSize
+	static void Compress(const uint8_t* src, uint32_t width, uint32_t height, TextureFormat format, uint32_t quality,
+		uint8_t* dst);
+}; // class BlockCompress
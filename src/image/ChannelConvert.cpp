@@ -0,0 +1,113 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#include "./ChannelConvert.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include <emmintrin.h>
+
+
+// ====================================================================================================================
+// Loads 4 pixels as RGBA, with gray expanded to RGB and missing alpha set to opaque
+static inline __m128i Load4(const uint8_t* src, uint32_t channels)
+{
+	const auto opaque = _mm_set1_epi32(int32_t(0xFF000000));
+	switch (channels) {
+		case 1: {
+			int32_t bits;
+			std::memcpy(&bits, src, 4);
+			const auto g = _mm_cvtsi32_si128(bits);
+			const auto gg = _mm_unpacklo_epi8(g, g);
+			const auto ga = _mm_unpacklo_epi8(g, _mm_set1_epi8(-1));
+			return _mm_unpacklo_epi16(gg, ga);
+		}
+		case 2: {
+			const auto ga = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+			const auto g = _mm_and_si128(ga, _mm_set1_epi16(0x00FF));
+			return _mm_unpacklo_epi16(_mm_or_si128(g, _mm_slli_epi16(g, 8)), ga);
+		}
+		case 3: {
+			// Reads 16 bytes, the caller makes sure that the extra 4 bytes are readable
+			const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+			const auto lo = _mm_unpacklo_epi32(v, _mm_srli_si128(v, 3));
+			const auto hi = _mm_unpacklo_epi32(_mm_srli_si128(v, 6), _mm_srli_si128(v, 9));
+			return _mm_or_si128(_mm_unpacklo_epi64(lo, hi), opaque);
+		}
+		default: return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+	}
+}
+
+// ====================================================================================================================
+// Stores 4 RGBA pixels with the channel count, writing exactly the bytes for the 4 pixels
+static inline void Store4(uint8_t* dst, uint32_t channels, __m128i rgba)
+{
+	switch (channels) {
+		case 1:
+		case 2: {
+			// Luma in each 32-bit lane, the multiplies are done as 16-bit pairs with zero high halves
+			const auto mask = _mm_set1_epi32(0xFF);
+			const auto r = _mm_madd_epi16(_mm_and_si128(rgba, mask), _mm_set1_epi32(77));
+			const auto g = _mm_madd_epi16(_mm_and_si128(_mm_srli_epi32(rgba, 8), mask), _mm_set1_epi32(150));
+			const auto b = _mm_madd_epi16(_mm_and_si128(_mm_srli_epi32(rgba, 16), mask), _mm_set1_epi32(29));
+			const auto y = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(r, g), b), 8);
+			if (channels == 1) {
+				const auto packed = _mm_packus_epi16(_mm_packs_epi32(y, y), y);
+				const int32_t bits = _mm_cvtsi128_si32(packed);
+				std::memcpy(dst, &bits, 4);
+			}
+			else {
+				// Gather the low word of each lane, as the (unsigned) values do not fit a signed pack
+				auto ya = _mm_or_si128(y, _mm_slli_epi32(_mm_srli_epi32(rgba, 24), 8));
+				ya = _mm_shufflelo_epi16(ya, _MM_SHUFFLE(0, 0, 2, 0));
+				ya = _mm_shufflehi_epi16(ya, _MM_SHUFFLE(0, 0, 2, 0));
+				ya = _mm_shuffle_epi32(ya, _MM_SHUFFLE(0, 0, 2, 0));
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(dst), ya);
+			}
+		} break;
+		case 3: {
+			// Pack pairs of pixels into 6 bytes in each 64-bit lane, then join the lanes into 12 bytes
+			const auto rgb = _mm_and_si128(rgba, _mm_set1_epi32(0x00FFFFFF));
+			const auto pairs = _mm_or_si128(_mm_and_si128(rgb, _mm_set_epi32(0, -1, 0, -1)),
+				_mm_slli_epi64(_mm_srli_epi64(rgb, 32), 24));
+			const auto joined = _mm_or_si128(_mm_move_epi64(pairs),
+				_mm_slli_si128(_mm_unpackhi_epi64(pairs, _mm_setzero_si128()), 6));
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(dst), joined);
+			const int32_t bits = _mm_cvtsi128_si32(_mm_srli_si128(joined, 8));
+			std::memcpy(dst + 8, &bits, 4);
+		} break;
+		default: _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), rgba); break;
+	}
+}
+
+
+// ====================================================================================================================
+void ChannelConvert::Convert(const uint8_t* src, uint32_t srcChannels, uint8_t* dst, uint32_t dstChannels,
+	size_t pixels)
+{
+	if (srcChannels == dstChannels) {
+		std::memcpy(dst, src, pixels * srcChannels);
+		return;
+	}
+
+	// 4 pixels per iteration, where 3 channel loads need 4 readable bytes past the pixels
+	const size_t extra = (srcChannels == 3) ? 2 : 0;
+	size_t i = 0;
+	for (; (i + 4 + extra) <= pixels; i += 4) {
+		Store4(dst + (i * dstChannels), dstChannels, Load4(src + (i * srcChannels), srcChannels));
+	}
+
+	// The remaining pixels are converted through temporary buffers
+	while (i < pixels) {
+		const size_t count = std::min(pixels - i, size_t(4));
+		uint8_t in[16]{ }, out[16];
+		std::memcpy(in, src + (i * srcChannels), count * srcChannels);
+		Store4(out, dstChannels, Load4(in, srcChannels));
+		std::memcpy(dst + (i * dstChannels), out, count * dstChannels);
+		i += count;
+	}
+}
@@ -0,0 +1,20 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include "../config.hpp"
+
+
+// Vectorized conversion of interleaved 8-bit pixels between channel counts
+// The results match the stb_image conversions exactly: gray is expanded to RGB, missing alpha is opaque, and RGB is
+// reduced to gray with the integer luma weights (77, 150, 29) / 256.
+class ChannelConvert final
+{
+public:
+	// Converts the pixels to the destination channel count, the buffers must not overlap
+	static void Convert(const uint8_t* src, uint32_t srcChannels, uint8_t* dst, uint32_t dstChannels, size_t pixels);
+}; // class ChannelConvert
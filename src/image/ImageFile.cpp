@@ -6,17 +6,86 @@
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "./ImageFile.hpp"
+#include "./ChannelConvert.hpp"
+#include "./Inflate.hpp"
+#include "./JpegKernels.hpp"
+#include "./PngUnfilter.hpp"
+#include "../util/CpuFeatures.hpp"
+#include "../util/ThreadPool.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <fstream>
+#include <new>
+#include <vector>
+
+
+// Runs the parallel stages of the stb_image JPEG decoder on the shared thread pool
+static void StbParallelFor(int count, void (*func)(void*, int), void* user)
+{
+	ThreadPool::Shared().parallelFor(size_t(count), [func, user](size_t index) { func(user, int(index)); });
+}
+
+// Installed when the library is loaded, the pool itself is only created on first use
+static const bool StbParallelInstalled{ (stbi_set_parallel_for(StbParallelFor), true) };
+
+// Replaces the stb_image JPEG kernels with the AVX2 versions if the CPU supports them
+static bool InstallJpegKernels()
+{
+	if (!CpuFeatures::HasAvx2()) {
+		return false;
+	}
+	stbi_jpeg_kernels kernels{ };
+	kernels.idct_block = JpegKernels::IdctAvx2;
+	kernels.YCbCr_to_RGB = JpegKernels::YCbCrToRgbAvx2;
+	kernels.resample_row_h_2 = JpegKernels::ResampleH2Avx2;
+	kernels.resample_row_hv_2 = JpegKernels::ResampleHV2Avx2;
+	stbi_set_jpeg_kernels(&kernels);
+	return true;
+}
+static const bool StbKernelsInstalled{ InstallJpegKernels() };
+
+// Runs the stb_image PNG unfiltering with the vectorized kernels
+static int StbPngUnfilter(stbi_uc* cur, const stbi_uc* prior, const stbi_uc* raw, int count, int filter, int bpp)
+{
+	return PngUnfilter::Unfilter(cur, prior, raw, uint32_t(count), uint32_t(filter), uint32_t(bpp)) ? 1 : 0;
+}
+static const bool StbPngUnfilterInstalled{ (stbi_set_png_unfilter(StbPngUnfilter), true) };
+
+#if defined(VEGA_FAST_INFLATE)
+// Decodes the PNG image data with the library inflate, into the exact size buffer from stb_image
+static int StbPngInflate(const stbi_zlib_span* in, int inCount, stbi_uc* out, int outLen, int parseHeader)
+{
+	std::vector<Inflate::Span> spans(size_t(inCount), Inflate::Span{ nullptr, 0 });
+	for (int i = 0; i < inCount; ++i) {
+		spans[size_t(i)] = { in[i].data, size_t(in[i].len) };
+	}
+	size_t written;
+	return Inflate::Decode(spans.data(), spans.size(), out, size_t(outLen), parseHeader != 0, &written) ?
+		int(written) : -1;
+}
+static const bool StbPngInflateInstalled{ (stbi_set_png_zlib_decode(StbPngInflate), true) };
+#endif // defined(VEGA_FAST_INFLATE)
 
 
 // ====================================================================================================================
 ImageFile::ImageFile(const std::string& path)
 	: path_{ path }
 	, type_{ DetectType(path) }
+	, file_{ }
+	, memory_{ nullptr }
+	, memorySize_{ 0 }
 	, info_{ }
+	, variants_{ }
+	, nativeChannels_{ 0 }
+	, directGray_{ false }
 	, dataPtr_{ nullptr }
+	, mips_{ }
+	, texture_{ }
+	, cached_{ }
+	, textureInfo_{ }
+	, textureLevels_{ }
 	, dataChannels_{ ImageChannels::UNKNOWN }
 	, lastError_{ ImageError::NO_ERROR }
 {
@@ -35,9 +104,81 @@ ImageFile::ImageFile(const std::string& path)
 		}
 	}
 
+	// Map the file, memory sizes are limited by the stb_image interface (except for texture files, which are not decoded)
+	file_.reset(new MappedFile(path));
+	if (!file_->isOpen() || ((file_->size() > uint64_t(INT32_MAX)) && !isTexture())) {
+		lastError_ = ImageError::INVALID_FILE;
+		return;
+	}
+	memory_ = file_->data();
+	memorySize_ = size_t(file_->size());
+
+	loadInfo();
+}
+
+// ====================================================================================================================
+ImageFile::ImageFile(const uint8_t* data, size_t size)
+	: path_{ }
+	, type_{ DetectType(data, size) }
+	, file_{ }
+	, memory_{ data }
+	, memorySize_{ size }
+	, info_{ }
+	, variants_{ }
+	, nativeChannels_{ 0 }
+	, directGray_{ false }
+	, dataPtr_{ nullptr }
+	, mips_{ }
+	, texture_{ }
+	, cached_{ }
+	, textureInfo_{ }
+	, textureLevels_{ }
+	, dataChannels_{ ImageChannels::UNKNOWN }
+	, lastError_{ ImageError::NO_ERROR }
+{
+	// Unknown type cut out early
+	if (type_ == ImageType::UNKNOWN) {
+		lastError_ = ImageError::UNKNOWN_TYPE;
+		return;
+	}
+
+	loadInfo();
+}
+
+// ====================================================================================================================
+ImageFile::~ImageFile()
+{
+	for (auto& data : variants_) {
+		if (data) {
+			stbi_image_free(data);
+			data = nullptr;
+		}
+	}
+	dataPtr_ = nullptr;
+}
+
+// ====================================================================================================================
+void ImageFile::loadInfo()
+{
+	// Texture files only have the header parsed
+	if (isTexture()) {
+		const auto parse = (type_ == ImageType::DDS) ? TextureContainer::ParseDDS : TextureContainer::ParseKTX2;
+		if (!parse(memory_, memorySize_, &info_.width, &info_.height, &textureInfo_, &textureLevels_)) {
+			lastError_ = ImageError::INVALID_FILE;
+			return;
+		}
+		switch (textureInfo_.format) {
+			case TextureFormat::BC1: info_.channels = ImageChannels::RGB; break;
+			case TextureFormat::BC4: info_.channels = ImageChannels::GRAY; break;
+			case TextureFormat::BC5: info_.channels = ImageChannels::GRAY_ALPHA; break;
+			default: info_.channels = ImageChannels::RGBA; break;
+		}
+		return;
+	}
+
 	// Load the file information
 	int x, y, channels;
-	if (!stbi_info(path.c_str(), &x, &y, &channels)) {
+	if (!stbi_info_from_memory(memory_, int(memorySize_), &x, &y, &channels)) {
 		lastError_ = ImageError::INVALID_FILE;
 		return;
 	}
@@ -48,16 +189,13 @@ ImageFile::ImageFile(const std::string& path)
 		case 2: info_.channels = ImageChannels::GRAY_ALPHA; break;
 		case 3: info_.channels = ImageChannels::RGB; break;
 		case 4: info_.channels = ImageChannels::RGBA; break;
-		default: lastError_ = ImageError::INVALID_CHANNELS; break;
+		default: lastError_ = ImageError::INVALID_CHANNELS; return;
 	}
-}
 
-// ====================================================================================================================
-ImageFile::~ImageFile()
-{
-	if (dataPtr_) {
-		stbi_image_free(dataPtr_);
-		dataPtr_ = nullptr;
+	// The JPEG decoder uses the Y channel for gray, and 16-bit PNG data is reduced to gray before the 8-bit conversion
+	if (channels >= 3) {
+		const bool is16Bit = (type_ == ImageType::PNG) && stbi_is_16_bit_from_memory(memory_, int(memorySize_));
+		directGray_ = (type_ == ImageType::JPEG) || is16Bit;
 	}
 }
 
@@ -77,21 +215,9 @@ bool ImageFile::loadData(const uint8_t** dataptr, ImageChannels channels)
 		return true;
 	}
 
-	// Free old data
-	if (dataPtr_) {
-		stbi_image_free(dataPtr_);
-		dataPtr_ = nullptr;
-		dataChannels_ = ImageChannels::UNKNOWN;
-	}
-
-	// Get new data
-	int x, y, c;
-	auto data = stbi_load(path_.c_str(), &x, &y, &c, GetChannelCount(channels));
-	if (!data || (x != info_.width) || (y != info_.height)) {
-		if (data) {
-			stbi_image_free(data);
-		}
-		lastError_ = ImageError::BAD_DATA_READ;
+	// Get the data, decoding or converting if not already loaded
+	const auto data = loadVariant(GetChannelCount(channels));
+	if (!data) {
 		*dataptr = nullptr;
 		return false;
 	}
@@ -104,6 +230,257 @@ bool ImageFile::loadData(const uint8_t** dataptr, ImageChannels channels)
 	return true;
 }
 
+// ====================================================================================================================
+bool ImageFile::decodeInto(ImageChannels channels, void* dst, size_t rowPitch)
+{
+	// Check for error state
+	if (hasError()) {
+		lastError_ = ImageError::BAD_STATE_READ;
+		return false;
+	}
+
+	// Check the destination
+	const int32_t channelCount = GetChannelCount(channels);
+	const size_t rowSize = size_t(info_.width) * channelCount;
+	if (!dst || (rowSize == 0) || (rowPitch < rowSize)) {
+		return false;
+	}
+
+	// Use the loaded data if possible, otherwise decode without keeping the data
+	const uint8_t* src = variants_[channelCount - 1];
+	int32_t srcChannels = channelCount;
+	uint8_t* decoded = nullptr;
+	if (!src && !isTexture() && ((nativeChannels_ == 0) || ((channelCount <= 2) && directGray_))) {
+		// JPEG and simple PNG images are decoded straight into the destination rows
+		const int result = stbi_load_from_memory_into(memory_, int(memorySize_), int(info_.width), int(info_.height),
+			channelCount, reinterpret_cast<uint8_t*>(dst), rowPitch);
+		if (result >= 0) {
+			lastError_ = (result == 1) ? ImageError::NO_ERROR : ImageError::BAD_DATA_READ;
+			return result == 1;
+		}
+	}
+	if (!src) {
+		if ((channelCount <= 2) && directGray_) {
+			src = decoded = decode(channelCount, nullptr);
+		}
+		else if (nativeChannels_ != 0) {
+			src = variants_[nativeChannels_ - 1];
+			srcChannels = int32_t(nativeChannels_);
+		}
+		else {
+			src = decoded = decode(0, &srcChannels);
+		}
+		if (!src) {
+			return false;
+		}
+	}
+
+	// Convert the rows into the destination
+	auto dstRow = reinterpret_cast<uint8_t*>(dst);
+	if (rowPitch == rowSize) {
+		ChannelConvert::Convert(src, srcChannels, dstRow, channelCount, size_t(info_.width) * info_.height);
+	}
+	else {
+		const size_t srcSize = size_t(info_.width) * srcChannels;
+		for (uint32_t ri = 0; ri < info_.height; ++ri, src += srcSize, dstRow += rowPitch) {
+			ChannelConvert::Convert(src, srcChannels, dstRow, channelCount, info_.width);
+		}
+	}
+	if (decoded) {
+		stbi_image_free(decoded);
+	}
+	lastError_ = ImageError::NO_ERROR;
+	return true;
+}
+
+// ====================================================================================================================
+bool ImageFile::generateMips(ImageChannels channels, const ImageMipOptions& options, ImageMipChain* chain)
+{
+	// Check for error state
+	if (hasError()) {
+		lastError_ = ImageError::BAD_STATE_READ;
+		return false;
+	}
+
+	// Check the options
+	if ((options.filter != ImageMipFilter::BOX) && (options.filter != ImageMipFilter::KAISER)) {
+		return false;
+	}
+
+	// Get the source data, decoding or converting if not already loaded
+	const int32_t channelCount = GetChannelCount(channels);
+	const auto data = loadVariant(channelCount);
+	if (!data) {
+		return false;
+	}
+	const uint32_t srcChannels = (channelCount != 0) ? uint32_t(channelCount) : nativeChannels_;
+
+	// Generate into a new chain, the last chain stays valid if the allocation fails
+	size_t offsets[ImageMipChain::MAX_LEVELS]{ };
+	const size_t size = MipGenerator::Layout(info_.width, info_.height, srcChannels, offsets);
+	std::unique_ptr<uint8_t[]> mips{ new (std::nothrow) uint8_t[size] };
+	if (!mips) {
+		lastError_ = ImageError::BAD_DATA_READ;
+		return false;
+	}
+	MipGenerator::Generate(data, info_.width, info_.height, srcChannels, options, mips.get());
+	mips_ = std::move(mips);
+
+	// Set values and return
+	chain->data = mips_.get();
+	chain->size = size;
+	chain->levelCount = MipGenerator::LevelCount(info_.width, info_.height);
+	std::memcpy(chain->offsets, offsets, sizeof(offsets));
+	lastError_ = ImageError::NO_ERROR;
+	return true;
+}
+
+// ====================================================================================================================
+bool ImageFile::compress(const ImageCompressOptions& options, ImageMipChain* chain)
+{
+	// Check for error state
+	if (hasError()) {
+		lastError_ = ImageError::BAD_STATE_READ;
+		return false;
+	}
+
+	// Check the options
+	if (BlockCompress::BlockSize(options.format) == 0) {
+		return false;
+	}
+	const ImageMipFilter filter = options.mipOptions.filter;
+	if (options.mipmaps && (filter != ImageMipFilter::BOX) && (filter != ImageMipFilter::KAISER)) {
+		return false;
+	}
+
+	// Get the RGBA data, and the mipmap chain if requested
+	const auto data = loadVariant(4);
+	if (!data) {
+		return false;
+	}
+	const uint32_t levels = options.mipmaps ? MipGenerator::LevelCount(info_.width, info_.height) : 1;
+	size_t mipOffsets[ImageMipChain::MAX_LEVELS]{ };
+	std::unique_ptr<uint8_t[]> mips{ };
+	if (options.mipmaps) {
+		mips.reset(new (std::nothrow) uint8_t[MipGenerator::Layout(info_.width, info_.height, 4, mipOffsets)]);
+		if (!mips) {
+			lastError_ = ImageError::BAD_DATA_READ;
+			return false;
+		}
+		MipGenerator::Generate(data, info_.width, info_.height, 4, options.mipOptions, mips.get());
+	}
+
+	// Compress each level into a new texture, the last texture stays valid if the allocation fails
+	size_t offsets[ImageMipChain::MAX_LEVELS]{ };
+	size_t size = 0;
+	for (uint32_t li = 0; li < levels; ++li) {
+		offsets[li] = size;
+		size += BlockCompress::LevelSize(options.format, std::max(info_.width >> li, 1u), std::max(info_.height >> li, 1u));
+	}
+	std::unique_ptr<uint8_t[]> texture{ new (std::nothrow) uint8_t[size] };
+	if (!texture) {
+		lastError_ = ImageError::BAD_DATA_READ;
+		return false;
+	}
+	for (uint32_t li = 0; li < levels; ++li) {
+		const uint8_t* const src = mips ? (mips.get() + mipOffsets[li]) : data;
+		BlockCompress::Compress(src, std::max(info_.width >> li, 1u), std::max(info_.height >> li, 1u), options.format,
+			options.quality, texture.get() + offsets[li]);
+	}
+	texture_ = std::move(texture);
+
+	// Set values and return
+	chain->data = texture_.get();
+	chain->size = size;
+	chain->levelCount = levels;
+	std::memcpy(chain->offsets, offsets, sizeof(offsets));
+	lastError_ = ImageError::NO_ERROR;
+	return true;
+}
+
+// ====================================================================================================================
+bool ImageFile::compressCached(const ImageCompressOptions& options, const std::string& cacheDir, ImageMipChain* chain)
+{
+	// Check for error state
+	if (hasError()) {
+		lastError_ = ImageError::BAD_STATE_READ;
+		return false;
+	}
+
+	// Check the cache, a matching entry only needs the header info of the image
+	const auto key = TextureCache::MakeKey(memory_, memorySize_, info_.width, info_.height, options);
+	const auto path = TextureCache::EntryPath(cacheDir, key);
+	if (TextureCache::Load(path, key, &cached_, chain)) {
+		lastError_ = ImageError::NO_ERROR;
+		return true;
+	}
+
+	// Compress and add the entry, failing to write the entry does not fail the compression
+	if (!compress(options, chain)) {
+		return false;
+	}
+	TextureCache::Save(path, key, *chain);
+	return true;
+}
+
+// ====================================================================================================================
+uint8_t* ImageFile::loadVariant(int32_t channels)
+{
+	if ((channels > 0) && variants_[channels - 1]) {
+		return variants_[channels - 1];
+	}
+	if ((channels == 1 || channels == 2) && directGray_) {
+		return (variants_[channels - 1] = decode(channels, nullptr));
+	}
+
+	// Decode once in the native channels (zero channels also selects the native channels)
+	if (nativeChannels_ == 0) {
+		int32_t actual;
+		const auto data = decode(0, &actual);
+		if (!data) {
+			return nullptr;
+		}
+		nativeChannels_ = uint32_t(actual);
+		variants_[actual - 1] = data;
+	}
+	const auto native = variants_[nativeChannels_ - 1];
+	if ((channels == 0) || (uint32_t(channels) == nativeChannels_)) {
+		return native;
+	}
+
+	// Convert from the native channels
+	const size_t pixels = size_t(info_.width) * info_.height;
+	const auto data = reinterpret_cast<uint8_t*>(stbi__malloc(pixels * channels));
+	if (!data) {
+		lastError_ = ImageError::BAD_DATA_READ;
+		return nullptr;
+	}
+	ChannelConvert::Convert(native, nativeChannels_, data, channels, pixels);
+	return (variants_[channels - 1] = data);
+}
+
+// ====================================================================================================================
+uint8_t* ImageFile::decode(int32_t channels, int32_t* actual)
+{
+	if (isTexture()) {
+		lastError_ = ImageError::BAD_DATA_READ;
+		return nullptr;
+	}
+	int x, y, c;
+	auto data = stbi_load_from_memory(memory_, int(memorySize_), &x, &y, &c, channels);
+	if (!data || (x != info_.width) || (y != info_.height) || (c < 1) || (c > 4)) {
+		if (data) {
+			stbi_image_free(data);
+		}
+		lastError_ = ImageError::BAD_DATA_READ;
+		return nullptr;
+	}
+	if (actual) {
+		*actual = c;
+	}
+	return data;
+}
+
 // ====================================================================================================================
 ImageType ImageFile::DetectType(const std::string& path)
 {
@@ -112,7 +489,7 @@ ImageType ImageFile::DetectType(const std::string& path)
 		return ImageType::UNKNOWN;
 	}
 	auto ext = path.substr(extPos);
-	std::transform(ext.begin(), ext.end(), ext.begin(), std::tolower);
+	std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
 
 	if (ext == ".jpg" || ext == ".jpeg") {
 		return ImageType::JPEG;
@@ -126,11 +503,50 @@ ImageType ImageFile::DetectType(const std::string& path)
 	else if (ext == ".bmp") {
 		return ImageType::BMP;
 	}
+	else if (ext == ".dds") {
+		return ImageType::DDS;
+	}
+	else if (ext == ".ktx2") {
+		return ImageType::KTX2;
+	}
 	else {
 		return ImageType::UNKNOWN;
 	}
 }
 
+// ====================================================================================================================
+ImageType ImageFile::DetectType(const uint8_t* data, size_t size)
+{
+	// Texture files are not decoded, so are not limited in size
+	if (data && TextureContainer::IsDDS(data, size)) {
+		return ImageType::DDS;
+	}
+	else if (data && TextureContainer::IsKTX2(data, size)) {
+		return ImageType::KTX2;
+	}
+
+	// Memory sizes are limited by the stb_image interface
+	if (!data || (size < 4) || (size > size_t(INT32_MAX))) {
+		return ImageType::UNKNOWN;
+	}
+
+	if ((data[0] == 0xFF) && (data[1] == 0xD8) && (data[2] == 0xFF)) {
+		return ImageType::JPEG;
+	}
+	else if ((data[0] == 0x89) && (data[1] == 'P') && (data[2] == 'N') && (data[3] == 'G')) {
+		return ImageType::PNG;
+	}
+	else if ((data[0] == 'B') && (data[1] == 'M')) {
+		return ImageType::BMP;
+	}
+	else {
+		// TGA does not have a signature, so check the header
+		stbi__context ctx;
+		stbi__start_mem(&ctx, data, int(size));
+		return stbi__tga_test(&ctx) ? ImageType::TGA : ImageType::UNKNOWN;
+	}
+}
+
 // ====================================================================================================================
 int32_t ImageFile::GetChannelCount(ImageChannels ch)
 {
@@ -142,3 +558,50 @@ int32_t ImageFile::GetChannelCount(ImageChannels ch)
 		default: return 0;
 	}
 }
+
+// ====================================================================================================================
+uint32_t ImageFile::LoadMany(const char* const* paths, uint32_t count, ImageChannels channels,
+	ImageLoadResult* results)
+{
+	auto& pool = ThreadPool::Shared();
+
+	// Open all of the files first, which only reads the headers
+	pool.parallelFor(count, [&](size_t index) {
+		auto& result = results[index];
+		result.handle = new ImageFile(paths[index]);
+		result.data = nullptr;
+		result.error = result.handle->error();
+		if (result.handle->hasError()) {
+			delete result.handle;
+			result.handle = nullptr;
+		}
+	});
+
+	// Decode the largest images first, so that a large image is not left to decode alone at the end of the batch
+	std::vector<uint32_t> order{ };
+	order.reserve(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		if (results[i].handle) {
+			order.push_back(i);
+		}
+	}
+	const auto pixels = [results](uint32_t index) {
+		const auto& info = results[index].handle->info();
+		return uint64_t(info.width) * info.height;
+	};
+	std::stable_sort(order.begin(), order.end(), [&pixels](uint32_t a, uint32_t b) { return pixels(a) > pixels(b); });
+
+	std::atomic<uint32_t> success{ 0 };
+	pool.parallelFor(order.size(), [&](size_t index) {
+		auto& result = results[order[index]];
+		if (result.handle->loadData(&result.data, channels)) {
+			success.fetch_add(1);
+		}
+		else {
+			result.error = result.handle->error();
+			delete result.handle;
+			result.handle = nullptr;
+		}
+	});
+	return success.load();
+}
@@ -7,6 +7,13 @@
 #pragma once
 
 #include "../config.hpp"
+#include "./BlockCompress.hpp"
+#include "./MipGenerator.hpp"
+#include "./TextureCache.hpp"
+#include "./TextureContainer.hpp"
+#include "../util/MappedFile.hpp"
+
+#include <memory>
 
 #define	STBI_NO_PSD
 #define	STBI_NO_GIF
@@ -38,6 +45,8 @@ enum class ImageType : uint32_t
 	PNG = 2,		// PNG file
 	TGA = 3,		// TGA file
 	BMP = 4,		// BMP file
+	DDS = 5,		// DDS texture file (only read as texture data)
+	KTX2 = 6,		// KTX2 texture file (only read as texture data)
 }; // enum class ImageType
 
 
@@ -62,14 +71,31 @@ public:
 }; // struct ImageInfo
 
 
+class ImageFile;
+
+// Describes the result of loading an image in a batch
+struct ImageLoadResult final
+{
+public:
+	ImageFile* handle;		// The open handle, which owns the data, or null on failure
+	const uint8_t* data;	// The loaded data, or null on failure
+	ImageError error;
+}; // struct ImageLoadResult
+
+
 // Represents a handle to an image file for providing info and reading
+// Files are memory mapped and decoded from memory, memory-backed handles instead borrow the caller's buffer, which
+// must remain valid for the lifetime of the handle
+// Texture files (DDS and KTX2) are not decoded, and instead provide their texture data directly from the file data
 class ImageFile final
 {
 public:
 	explicit ImageFile(const std::string& path);
+	ImageFile(const uint8_t* data, size_t size);
 	~ImageFile();
 
 	inline const std::string& path() const { return path_; }
+	inline bool isMemory() const { return path_.empty(); }
 	inline ImageType type() const { return type_; }
 	inline const ImageInfo& info() const { return info_; }
 	inline const uint8_t* dataPtr() const { return dataPtr_; }
@@ -77,17 +103,57 @@ public:
 	inline ImageChannels dataChannels() const { return dataChannels_; }
 	inline ImageError error() const { return lastError_; }
 	inline bool hasError() const { return lastError_ != ImageError::NO_ERROR; }
+	inline bool isTexture() const { return (type_ == ImageType::DDS) || (type_ == ImageType::KTX2); }
+	inline const ImageTextureInfo& textureInfo() const { return textureInfo_; }
+	inline const ImageMipChain& textureLevels() const { return textureLevels_; }
 
+	// Loads the data with the channel count, which stays valid until the handle is closed
+	// The image is only decoded once, and the data for other channel counts is converted from the first decode
 	bool loadData(const uint8_t** dataptr, ImageChannels channels);
+	// Decodes the image into caller memory, with each row starting rowPitch bytes after the previous row
+	// The decoded data is not kept by the handle, but already loaded data is converted instead if available. JPEG
+	// images, and 8-bit PNG images without a palette, transparency, or interlacing that need no channel conversion, are
+	// decoded directly into the rows, other images are decoded into temporary memory and converted into the rows.
+	// An invalid destination (null, or a row pitch smaller than a row) returns false without changing the handle state
+	bool decodeInto(ImageChannels channels, void* dst, size_t rowPitch);
+	// Generates the full mipmap chain of the data with the channel count (unknown channels selects the file channels)
+	// The chain is owned by the handle, and stays valid until the next call or until the handle is closed
+	bool generateMips(ImageChannels channels, const ImageMipOptions& options, ImageMipChain* chain);
+	// Compresses the RGBA data into texture data, with the mipmap chain if requested
+	// The texture data is owned by the handle, and stays valid until the next call or until the handle is closed
+	bool compress(const ImageCompressOptions& options, ImageMipChain* chain);
+	// Same as compress, but first checks the cache directory for an entry matching the file contents and options
+	// Entries that are found are mapped without decoding the image, otherwise the new texture data is added as an entry
+	bool compressCached(const ImageCompressOptions& options, const std::string& cacheDir, ImageMipChain* chain);
 
 	static ImageType DetectType(const std::string& path);
+	static ImageType DetectType(const uint8_t* data, size_t size);
 	static int32_t GetChannelCount(ImageChannels ch);
+	// Opens and loads a set of files in parallel on the shared thread pool, returns the number of successful loads
+	static uint32_t LoadMany(const char* const* paths, uint32_t count, ImageChannels channels,
+		ImageLoadResult* results);
+
+private:
+	void loadInfo();
+	uint8_t* loadVariant(int32_t channels);
+	uint8_t* decode(int32_t channels, int32_t* actual);
 
 private:
 	const std::string path_;
 	const ImageType type_;
+	std::unique_ptr<MappedFile> file_;
+	const uint8_t* memory_;		// The encoded data, from the file mapping or the caller
+	size_t memorySize_;
 	ImageInfo info_;
-	uint8_t* dataPtr_;
+	uint8_t* variants_[4];		// The loaded data for each channel count, allocated by stb_image
+	uint32_t nativeChannels_;	// The channel count of the first decode, or zero if not yet decoded
+	bool directGray_;			// If gray data is decoded directly, as the decoder does not use the converted luma
+	uint8_t* dataPtr_;			// The most recently loaded data
+	std::unique_ptr<uint8_t[]> mips_;	// The most recently generated mipmap chain
+	std::unique_ptr<uint8_t[]> texture_;	// The most recently compressed texture data
+	std::unique_ptr<MappedFile> cached_;	// The most recently mapped texture cache entry
+	ImageTextureInfo textureInfo_;		// The texture data info for texture files
+	ImageMipChain textureLevels_;		// The texture data levels for texture files, which point into the file data
 	ImageChannels dataChannels_;
 	ImageError lastError_;
 }; // class ImageFile
@@ -0,0 +1,58 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#include "./ImageTicket.hpp"
+#include "../util/ThreadPool.hpp"
+
+
+// ====================================================================================================================
+ImageTicket::ImageTicket(ImageFile* file, ImageChannels channels, ImageLoadCallback callback, void* userData)
+	: file_{ file }
+	, channels_{ channels }
+	, callback_{ callback }
+	, userData_{ userData }
+	, mutex_{ }
+	, cond_{ }
+	, status_{ ImageTicketStatus::PENDING }
+{
+	// The ticket outlives the task, as the destructor waits for the load
+	ThreadPool::Shared().submit([this]() { run(); });
+}
+
+// ====================================================================================================================
+ImageTicket::~ImageTicket()
+{
+	wait();
+}
+
+// ====================================================================================================================
+ImageTicketStatus ImageTicket::status() const
+{
+	std::lock_guard<std::mutex> lock{ mutex_ };
+	return status_;
+}
+
+// ====================================================================================================================
+ImageTicketStatus ImageTicket::wait() const
+{
+	std::unique_lock<std::mutex> lock{ mutex_ };
+	cond_.wait(lock, [this]() { return status_ != ImageTicketStatus::PENDING; });
+	return status_;
+}
+
+// ====================================================================================================================
+void ImageTicket::run()
+{
+	const uint8_t* data;
+	const bool success = file_->loadData(&data, channels_);
+	if (callback_) {
+		callback_(file_, file_->error(), userData_);
+	}
+
+	std::lock_guard<std::mutex> lock{ mutex_ };
+	status_ = success ? ImageTicketStatus::COMPLETE : ImageTicketStatus::FAILED;
+	cond_.notify_all();
+}
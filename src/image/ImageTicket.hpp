@@ -0,0 +1,56 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include "./ImageFile.hpp"
+
+#include <condition_variable>
+#include <mutex>
+
+
+// Describes the state of an asynchronous image load
+enum class ImageTicketStatus : uint32_t
+{
+	PENDING = 0,	// The load is queued or running
+	COMPLETE = 1,	// The data is loaded, and can be accessed through the handle
+	FAILED = 2,		// The load failed, with the reason given by the handle error
+}; // enum class ImageTicketStatus
+
+
+// Called on the worker thread once a load is finished, before the ticket is complete
+typedef void(*ImageLoadCallback)(ImageFile* handle, ImageError error, void* userData);
+
+
+// Tracks the load of image data on the shared thread pool
+// The handle must not be used or closed while the load is pending. Destroying the ticket waits for the load.
+class ImageTicket final
+{
+public:
+	ImageTicket(ImageFile* file, ImageChannels channels, ImageLoadCallback callback, void* userData);
+	~ImageTicket();
+
+	ImageTicket(const ImageTicket&) = delete;
+	ImageTicket& operator = (const ImageTicket&) = delete;
+
+	inline ImageFile* file() const { return file_; }
+
+	ImageTicketStatus status() const;
+	// Blocks until the load is finished, and returns the final status
+	ImageTicketStatus wait() const;
+
+private:
+	void run();
+
+private:
+	ImageFile* const file_;
+	const ImageChannels channels_;
+	const ImageLoadCallback callback_;
+	void* const userData_;
+	mutable std::mutex mutex_;
+	mutable std::condition_variable cond_;
+	ImageTicketStatus status_;
+}; // class ImageTicket
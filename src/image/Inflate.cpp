@@ -0,0 +1,617 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#include "./Inflate.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+
+// Root table bits, and the largest possible table sizes for those bits (from the zlib 'enough' utility)
+static constexpr uint32_t LITLEN_BITS{ 11 };
+static constexpr uint32_t DIST_BITS{ 8 };
+static constexpr uint32_t PRECODE_BITS{ 7 };
+static constexpr uint32_t LITLEN_ENOUGH{ 2342 };
+static constexpr uint32_t DIST_ENOUGH{ 402 };
+static constexpr uint32_t MAX_CODE_BITS{ 15 };
+// Alphabet sizes, including the two unused symbols of each alphabet that appear in the fixed codes
+static constexpr uint32_t LITLEN_SYMBOLS{ 288 };
+static constexpr uint32_t DIST_SYMBOLS{ 32 };
+static constexpr uint32_t PRECODE_SYMBOLS{ 19 };
+static constexpr uint32_t END_SYMBOL{ 256 };
+// The fast loop runs while it can refill 8 bytes at a time, and write the longest match plus the copy overrun
+static constexpr size_t FAST_IN_SPACE{ 8 };
+static constexpr size_t FAST_OUT_SPACE{ 258 + 8 };
+
+// Table entries: bits 0-7 are the bits to drop, 8-11 the extra bits (subtable bits for subtables), 12-15 the kind,
+// and 16-31 the payload (one or two literals, length or distance base, subtable offset, or precode symbol)
+static constexpr uint32_t KIND_INVALID{ 0u << 12 };
+static constexpr uint32_t KIND_LITERAL{ 1u << 12 };
+static constexpr uint32_t KIND_LITERAL2{ 2u << 12 };
+static constexpr uint32_t KIND_LENGTH{ 3u << 12 };
+static constexpr uint32_t KIND_END{ 4u << 12 };
+static constexpr uint32_t KIND_SUBTABLE{ 5u << 12 };
+static constexpr uint32_t KIND_DISTANCE{ 6u << 12 };
+static constexpr uint32_t KIND_SYMBOL{ 7u << 12 };
+static constexpr uint32_t KIND_MASK{ 0xFu << 12 };
+
+static constexpr uint16_t LENGTH_BASE[29]{
+	3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static constexpr uint8_t LENGTH_EXTRA[29]{
+	0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static constexpr uint16_t DIST_BASE[30]{
+	1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+	8193, 12289, 16385, 24577
+};
+static constexpr uint8_t DIST_EXTRA[30]{
+	0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+static constexpr uint8_t PRECODE_ORDER[PRECODE_SYMBOLS]{
+	16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+// The input bits, and the output written so far
+struct BitStream final
+{
+public:
+	const uint8_t* in;
+	const uint8_t* inEnd;
+	const Inflate::Span* span;		// The next span to read after inEnd
+	const Inflate::Span* spanEnd;
+	uint64_t bits;			// Bits above 'count' are either zero, or the next input bits
+	uint32_t count;			// Valid bits in 'bits'
+	uint32_t overrun;		// Zero bytes added to 'bits' after the end of the input
+	uint8_t* outStart;
+	uint8_t* out;
+	uint8_t* outEnd;
+}; // struct BitStream
+
+// The decode tables for a block
+struct DecodeTables final
+{
+public:
+	uint32_t litlen[LITLEN_ENOUGH];
+	uint32_t dist[DIST_ENOUGH];
+}; // struct DecodeTables
+
+
+// ====================================================================================================================
+static inline uint32_t EntryLength(uint32_t entry) { return entry & 0xFF; }
+static inline uint32_t EntryExtra(uint32_t entry) { return (entry >> 8) & 0xF; }
+static inline uint32_t EntryPayload(uint32_t entry) { return entry >> 16; }
+
+// ====================================================================================================================
+static uint32_t LitLenEntry(uint32_t symbol)
+{
+	if (symbol < END_SYMBOL) {
+		return KIND_LITERAL | (symbol << 16);
+	}
+	if (symbol == END_SYMBOL) {
+		return KIND_END;
+	}
+	if (symbol < 286) {
+		const uint32_t index = symbol - (END_SYMBOL + 1);
+		return KIND_LENGTH | (uint32_t(LENGTH_BASE[index]) << 16) | (uint32_t(LENGTH_EXTRA[index]) << 8);
+	}
+	return KIND_INVALID;
+}
+
+// ====================================================================================================================
+static uint32_t DistEntry(uint32_t symbol)
+{
+	if (symbol < 30) {
+		return KIND_DISTANCE | (uint32_t(DIST_BASE[symbol]) << 16) | (uint32_t(DIST_EXTRA[symbol]) << 8);
+	}
+	return KIND_INVALID;
+}
+
+// ====================================================================================================================
+static uint32_t PrecodeEntry(uint32_t symbol)
+{
+	return KIND_SYMBOL | (symbol << 16);
+}
+
+// ====================================================================================================================
+static inline uint32_t ReverseBits(uint32_t code, uint32_t length)
+{
+	uint32_t reversed = 0;
+	for (uint32_t i = 0; i < length; ++i, code >>= 1) {
+		reversed = (reversed << 1) | (code & 1);
+	}
+	return reversed;
+}
+
+// ====================================================================================================================
+// Builds a decode table for the code lengths, with subtables for the codes longer than the root bits. Incomplete codes
+// are allowed (their unused entries are invalid), but over-subscribed codes are not.
+static bool BuildTable(const uint8_t* lengths, uint32_t symbolCount, uint32_t(*entryFor)(uint32_t), uint32_t rootBits,
+	uint32_t* table, uint32_t tableSize)
+{
+	uint32_t counts[MAX_CODE_BITS + 1]{ };
+	for (uint32_t i = 0; i < symbolCount; ++i) {
+		++counts[lengths[i]];
+	}
+	counts[0] = 0;
+	int32_t left = 1;
+	uint32_t maxLength = 0;
+	for (uint32_t len = 1; len <= MAX_CODE_BITS; ++len) {
+		left = (left << 1) - int32_t(counts[len]);
+		if (left < 0) {
+			return false;
+		}
+		if (counts[len] != 0) {
+			maxLength = len;
+		}
+	}
+
+	// Symbols sorted by length then value, which is the order of the canonical codes
+	uint32_t offsets[MAX_CODE_BITS + 2]{ };
+	for (uint32_t len = 1; len <= MAX_CODE_BITS; ++len) {
+		offsets[len + 1] = offsets[len] + counts[len];
+	}
+	uint16_t sorted[LITLEN_SYMBOLS];
+	for (uint32_t i = 0; i < symbolCount; ++i) {
+		if (lengths[i] != 0) {
+			sorted[offsets[lengths[i]]++] = uint16_t(i);
+		}
+	}
+
+	// Codes are read starting at the low bit, so the table is indexed by the reversed codes
+	std::fill(table, table + tableSize, KIND_INVALID);
+	uint32_t remaining[MAX_CODE_BITS + 1];
+	std::memcpy(remaining, counts, sizeof(counts));
+	const uint32_t rootSize = 1u << rootBits;
+	uint32_t code = 0, sortIndex = 0, nextSubtable = rootSize;
+	uint32_t subPrefix = UINT32_MAX, subStart = 0, subBits = 0;
+	for (uint32_t len = 1; len <= maxLength; ++len, code <<= 1) {
+		for (uint32_t ci = 0; ci < counts[len]; ++ci, ++code) {
+			const uint32_t entry = entryFor(sorted[sortIndex++]);
+			const uint32_t reversed = ReverseBits(code, len);
+			if (len <= rootBits) {
+				for (uint32_t ti = reversed; ti < rootSize; ti += (1u << len)) {
+					table[ti] = entry | len;
+				}
+			}
+			else {
+				const uint32_t prefix = reversed & (rootSize - 1);
+				if (prefix != subPrefix) {
+					// Size the subtable to hold the remaining codes with this prefix, same as zlib
+					subBits = len - rootBits;
+					int32_t room = 1 << subBits;
+					while ((subBits + rootBits) < maxLength) {
+						room -= int32_t(remaining[subBits + rootBits]);
+						if (room <= 0) {
+							break;
+						}
+						++subBits;
+						room <<= 1;
+					}
+					if ((nextSubtable + (1u << subBits)) > tableSize) {
+						return false;
+					}
+					subPrefix = prefix;
+					subStart = nextSubtable;
+					nextSubtable += (1u << subBits);
+					table[prefix] = KIND_SUBTABLE | (subStart << 16) | (subBits << 8) | rootBits;
+				}
+				const uint32_t subLength = len - rootBits;
+				for (uint32_t ti = (reversed >> rootBits); ti < (1u << subBits); ti += (1u << subLength)) {
+					table[subStart + ti] = entry | subLength;
+				}
+			}
+			--remaining[len];
+		}
+	}
+	return true;
+}
+
+// ====================================================================================================================
+// Merges pairs of literals into single root table entries, where both codes fit into the root bits
+static void PairLiterals(uint32_t* table)
+{
+	// The second entry is at a lower index, so going downwards it is always still a single literal
+	for (uint32_t ti = (1u << LITLEN_BITS); ti-- > 0; ) {
+		const uint32_t first = table[ti];
+		if ((first & KIND_MASK) != KIND_LITERAL) {
+			continue;
+		}
+		const uint32_t firstLength = EntryLength(first);
+		const uint32_t second = table[ti >> firstLength];
+		const uint32_t length = firstLength + EntryLength(second);
+		if (((second & KIND_MASK) != KIND_LITERAL) || (length > LITLEN_BITS)) {
+			continue;
+		}
+		table[ti] = KIND_LITERAL2 | ((EntryPayload(first) | (EntryPayload(second) << 8)) << 16) | length;
+	}
+}
+
+// ====================================================================================================================
+// The tables for the fixed codes, built on first use
+static const DecodeTables& FixedTables()
+{
+	struct Builder final
+	{
+	public:
+		Builder() : tables{ } {
+			uint8_t lengths[LITLEN_SYMBOLS];
+			std::fill(lengths, lengths + 144, uint8_t(8));
+			std::fill(lengths + 144, lengths + 256, uint8_t(9));
+			std::fill(lengths + 256, lengths + 280, uint8_t(7));
+			std::fill(lengths + 280, lengths + LITLEN_SYMBOLS, uint8_t(8));
+			BuildTable(lengths, LITLEN_SYMBOLS, LitLenEntry, LITLEN_BITS, tables.litlen, LITLEN_ENOUGH);
+			PairLiterals(tables.litlen);
+			std::fill(lengths, lengths + DIST_SYMBOLS, uint8_t(5));
+			BuildTable(lengths, DIST_SYMBOLS, DistEntry, DIST_BITS, tables.dist, DIST_ENOUGH);
+		}
+		DecodeTables tables;
+	}; // struct Builder
+
+	static const Builder builder{ };
+	return builder.tables;
+}
+
+// ====================================================================================================================
+static inline uint64_t Load64(const uint8_t* src)
+{
+	uint64_t value;
+	std::memcpy(&value, src, sizeof(value));
+	return value;
+}
+
+// ====================================================================================================================
+// Moves on to the next non-empty span of input, returns false if there is none
+static bool NextSpan(BitStream& bs)
+{
+	while (bs.span < bs.spanEnd) {
+		bs.in = bs.span->data;
+		bs.inEnd = bs.span->data + bs.span->size;
+		++bs.span;
+		if (bs.in < bs.inEnd) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// ====================================================================================================================
+// Refills to at least 56 bits one byte at a time, adding zero bytes after the end of the input
+static inline void Refill(BitStream& bs)
+{
+	while (bs.count < 56) {
+		if ((bs.in < bs.inEnd) || NextSpan(bs)) {
+			bs.bits |= uint64_t(*bs.in++) << bs.count;
+		}
+		else {
+			++bs.overrun;
+		}
+		bs.count += 8;
+	}
+}
+
+// ====================================================================================================================
+static inline uint32_t TakeBits(BitStream& bs, uint32_t count)
+{
+	const uint32_t value = uint32_t(bs.bits & ((uint64_t(1) << count) - 1));
+	bs.bits >>= count;
+	bs.count -= count;
+	return value;
+}
+
+// ====================================================================================================================
+// Checks if any of the zero bytes added after the end of the input were used
+static inline bool IsPastEnd(const BitStream& bs)
+{
+	return (bs.overrun * 8) > bs.count;
+}
+
+// ====================================================================================================================
+// Copies a match with room for 8 bytes past the end of the match
+static inline void CopyMatchFast(uint8_t* out, size_t distance, uint32_t length)
+{
+	const uint8_t* src = out - distance;
+	uint8_t* const end = out + length;
+	if (distance >= 8) {
+		do {
+			std::memcpy(out, src, 8);
+			out += 8;
+			src += 8;
+		} while (out < end);
+	}
+	else if (distance == 1) {
+		std::memset(out, *src, length);
+	}
+	else {
+		do {
+			*out++ = *src++;
+		} while (out < end);
+	}
+}
+
+// ====================================================================================================================
+// Decodes the symbols of a block until the end of the block (returns true), the output is full (returns true), or
+// the data is corrupt (returns false)
+static bool DecodeBlock(BitStream& bs, const DecodeTables& tables)
+{
+	const uint32_t* const litlen = tables.litlen;
+	const uint32_t* const dist = tables.dist;
+	constexpr uint64_t litlenMask{ (1u << LITLEN_BITS) - 1 };
+	constexpr uint64_t distMask{ (1u << DIST_BITS) - 1 };
+
+	for (;;) {
+		// Fast loop, one refill covers the longest length and distance codes with their extra bits (48 bits)
+		const uint8_t* in = bs.in;
+		const uint8_t* const inFastEnd = bs.inEnd - std::min<size_t>(size_t(bs.inEnd - bs.in), FAST_IN_SPACE);
+		uint8_t* out = bs.out;
+		uint8_t* const outFastEnd = bs.outEnd - std::min<size_t>(size_t(bs.outEnd - bs.out), FAST_OUT_SPACE);
+		uint64_t bits = bs.bits;
+		uint32_t count = bs.count;
+		bool ended = false, corrupt = false;
+		while ((in < inFastEnd) && (out < outFastEnd)) {
+			bits |= Load64(in) << count;
+			in += (63 - count) >> 3;
+			count |= 56;
+
+			uint32_t entry = litlen[bits & litlenMask];
+			if ((entry & KIND_MASK) == KIND_SUBTABLE) {
+				bits >>= LITLEN_BITS;
+				count -= LITLEN_BITS;
+				entry = litlen[EntryPayload(entry) + (bits & ((1u << EntryExtra(entry)) - 1))];
+			}
+			bits >>= EntryLength(entry);
+			count -= EntryLength(entry);
+			const uint32_t kind = entry & KIND_MASK;
+			if (kind == KIND_LITERAL2) {
+				out[0] = uint8_t(entry >> 16);
+				out[1] = uint8_t(entry >> 24);
+				out += 2;
+				continue;
+			}
+			if (kind == KIND_LITERAL) {
+				*out++ = uint8_t(entry >> 16);
+				continue;
+			}
+			if (kind != KIND_LENGTH) {
+				ended = (kind == KIND_END);
+				corrupt = !ended;
+				break;
+			}
+			const uint32_t lengthExtra = EntryExtra(entry);
+			const uint32_t length = EntryPayload(entry) + uint32_t(bits & ((1u << lengthExtra) - 1));
+			bits >>= lengthExtra;
+			count -= lengthExtra;
+
+			entry = dist[bits & distMask];
+			if ((entry & KIND_MASK) == KIND_SUBTABLE) {
+				bits >>= DIST_BITS;
+				count -= DIST_BITS;
+				entry = dist[EntryPayload(entry) + (bits & ((1u << EntryExtra(entry)) - 1))];
+			}
+			bits >>= EntryLength(entry);
+			count -= EntryLength(entry);
+			const uint32_t distExtra = EntryExtra(entry);
+			const size_t distance = EntryPayload(entry) + size_t(bits & ((1u << distExtra) - 1));
+			bits >>= distExtra;
+			count -= distExtra;
+			if (((entry & KIND_MASK) != KIND_DISTANCE) || (distance > size_t(out - bs.outStart))) {
+				corrupt = true;
+				break;
+			}
+			CopyMatchFast(out, distance, length);
+			out += length;
+		}
+		bs.in = in;
+		bs.out = out;
+		bs.bits = bits;
+		bs.count = count;
+		if (ended || corrupt) {
+			return ended;
+		}
+
+		// Checked loop for the end of the input and output, until there is space for the fast loop again
+		for (;;) {
+			if (bs.out == bs.outEnd) {
+				return true;
+			}
+			if ((size_t(bs.inEnd - bs.in) > FAST_IN_SPACE) && (size_t(bs.outEnd - bs.out) > FAST_OUT_SPACE)) {
+				break;
+			}
+			Refill(bs);
+			uint32_t entry = litlen[bs.bits & litlenMask];
+			if ((entry & KIND_MASK) == KIND_SUBTABLE) {
+				TakeBits(bs, LITLEN_BITS);
+				entry = litlen[EntryPayload(entry) + (bs.bits & ((1u << EntryExtra(entry)) - 1))];
+			}
+			TakeBits(bs, EntryLength(entry));
+			const uint32_t kind = entry & KIND_MASK;
+			if (kind == KIND_LITERAL || kind == KIND_LITERAL2) {
+				if (IsPastEnd(bs)) {
+					return false;
+				}
+				*bs.out++ = uint8_t(entry >> 16);
+				if ((kind == KIND_LITERAL2) && (bs.out < bs.outEnd)) {
+					*bs.out++ = uint8_t(entry >> 24);
+				}
+				continue;
+			}
+			if (kind != KIND_LENGTH) {
+				return (kind == KIND_END) && !IsPastEnd(bs);
+			}
+			const uint32_t length = EntryPayload(entry) + TakeBits(bs, EntryExtra(entry));
+
+			entry = dist[bs.bits & distMask];
+			if ((entry & KIND_MASK) == KIND_SUBTABLE) {
+				TakeBits(bs, DIST_BITS);
+				entry = dist[EntryPayload(entry) + (bs.bits & ((1u << EntryExtra(entry)) - 1))];
+			}
+			TakeBits(bs, EntryLength(entry));
+			const size_t distance = EntryPayload(entry) + size_t(TakeBits(bs, EntryExtra(entry)));
+			if (((entry & KIND_MASK) != KIND_DISTANCE) || (distance > size_t(bs.out - bs.outStart)) || IsPastEnd(bs)) {
+				return false;
+			}
+			const size_t copy = std::min<size_t>(length, size_t(bs.outEnd - bs.out));
+			const uint8_t* src = bs.out - distance;
+			for (size_t i = 0; i < copy; ++i) {
+				bs.out[i] = src[i];
+			}
+			bs.out += copy;
+		}
+	}
+}
+
+// ====================================================================================================================
+// Copies a stored block, the block header bits have already been read
+static bool CopyStored(BitStream& bs)
+{
+	TakeBits(bs, bs.count & 7);
+	Refill(bs);
+	const uint32_t length = TakeBits(bs, 16);
+	const uint32_t inverse = TakeBits(bs, 16);
+	if (IsPastEnd(bs) || (length != (~inverse & 0xFFFF))) {
+		return false;
+	}
+
+	// The first bytes are already in the bit buffer
+	uint32_t left = length;
+	for (; (left > 0) && (bs.count > 0) && (bs.out < bs.outEnd); --left) {
+		*bs.out++ = uint8_t(TakeBits(bs, 8));
+		if (IsPastEnd(bs)) {
+			return false;
+		}
+	}
+
+	// The rest is copied directly from the input, which leaves nothing in the bit buffer
+	if ((left > 0) && (bs.out < bs.outEnd)) {
+		bs.bits = 0;
+		while ((left > 0) && (bs.out < bs.outEnd)) {
+			if ((bs.in == bs.inEnd) && !NextSpan(bs)) {
+				return false;
+			}
+			const size_t copy = std::min({ size_t(left), size_t(bs.inEnd - bs.in), size_t(bs.outEnd - bs.out) });
+			std::memcpy(bs.out, bs.in, copy);
+			bs.out += copy;
+			bs.in += copy;
+			left -= uint32_t(copy);
+		}
+	}
+	return true;
+}
+
+// ====================================================================================================================
+// Reads the code lengths for a dynamic block, and builds the tables for them
+static bool ReadDynamicTables(BitStream& bs, DecodeTables* tables)
+{
+	Refill(bs);
+	const uint32_t litlenCount = TakeBits(bs, 5) + 257;
+	const uint32_t distCount = TakeBits(bs, 5) + 1;
+	const uint32_t precodeCount = TakeBits(bs, 4) + 4;
+	if ((litlenCount > 286) || (distCount > 30)) {
+		return false;
+	}
+
+	// Code lengths for the code length alphabet (the precode)
+	uint8_t precodeLengths[PRECODE_SYMBOLS]{ };
+	for (uint32_t i = 0; i < precodeCount; ++i) {
+		Refill(bs);
+		precodeLengths[PRECODE_ORDER[i]] = uint8_t(TakeBits(bs, 3));
+	}
+	uint32_t precode[1u << PRECODE_BITS];
+	if (!BuildTable(precodeLengths, PRECODE_SYMBOLS, PrecodeEntry, PRECODE_BITS, precode, 1u << PRECODE_BITS)) {
+		return false;
+	}
+
+	// Code lengths for the literal/length and distance alphabets, as one sequence
+	uint8_t lengths[LITLEN_SYMBOLS + DIST_SYMBOLS]{ };
+	const uint32_t total = litlenCount + distCount;
+	for (uint32_t i = 0; i < total; ) {
+		Refill(bs);
+		const uint32_t entry = precode[bs.bits & ((1u << PRECODE_BITS) - 1)];
+		if ((entry & KIND_MASK) != KIND_SYMBOL) {
+			return false;
+		}
+		TakeBits(bs, EntryLength(entry));
+		const uint32_t symbol = EntryPayload(entry);
+		if (symbol < 16) {
+			lengths[i++] = uint8_t(symbol);
+			continue;
+		}
+		uint8_t value = 0;
+		uint32_t repeat;
+		if (symbol == 16) {
+			if (i == 0) {
+				return false;
+			}
+			value = lengths[i - 1];
+			repeat = 3 + TakeBits(bs, 2);
+		}
+		else if (symbol == 17) {
+			repeat = 3 + TakeBits(bs, 3);
+		}
+		else {
+			repeat = 11 + TakeBits(bs, 7);
+		}
+		if (repeat > (total - i)) {
+			return false;
+		}
+		std::memset(lengths + i, value, repeat);
+		i += repeat;
+	}
+	if (IsPastEnd(bs) || (lengths[END_SYMBOL] == 0)) {
+		return false;
+	}
+
+	if (!BuildTable(lengths, litlenCount, LitLenEntry, LITLEN_BITS, tables->litlen, LITLEN_ENOUGH) ||
+		!BuildTable(lengths + litlenCount, distCount, DistEntry, DIST_BITS, tables->dist, DIST_ENOUGH)) {
+		return false;
+	}
+	PairLiterals(tables->litlen);
+	return true;
+}
+
+// ====================================================================================================================
+bool Inflate::Decode(const Span* spans, size_t spanCount, uint8_t* out, size_t outSize, bool zlibHeader,
+	size_t* written)
+{
+	BitStream bs{ nullptr, nullptr, spans, spans + spanCount, 0, 0, 0, out, out, out + outSize };
+	*written = 0;
+	if (zlibHeader) {
+		// Same checks as stb_image: deflate method, valid check bits, and no preset dictionary
+		Refill(bs);
+		const uint32_t cmf = TakeBits(bs, 8);
+		const uint32_t flg = TakeBits(bs, 8);
+		if (IsPastEnd(bs) || ((((cmf << 8) | flg) % 31) != 0) || ((flg & 0x20) != 0) || ((cmf & 0xF) != 8)) {
+			return false;
+		}
+	}
+
+	DecodeTables dynamic;
+	bool last = false;
+	while (!last && (bs.out < bs.outEnd)) {
+		Refill(bs);
+		last = TakeBits(bs, 1) != 0;
+		const uint32_t type = TakeBits(bs, 2);
+		bool ok;
+		if (type == 0) {
+			ok = CopyStored(bs);
+		}
+		else if (type == 1) {
+			ok = DecodeBlock(bs, FixedTables());
+		}
+		else if (type == 2) {
+			ok = ReadDynamicTables(bs, &dynamic) && DecodeBlock(bs, dynamic);
+		}
+		else {
+			ok = false;
+		}
+		if (!ok || IsPastEnd(bs)) {
+			*written = size_t(bs.out - out);
+			return false;
+		}
+	}
+	*written = size_t(bs.out - out);
+	return true;
+}
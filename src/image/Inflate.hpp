@@ -0,0 +1,39 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include "../config.hpp"
+
+
+// A deflate (RFC 1951) decoder for streams with a known decoded size, used in place of the stb_image zlib decoder
+// Bits are read through a 64-bit buffer that is refilled without branches, the literal/length table decodes two
+// literals in one lookup when both codes fit in the table bits, and matches are copied 8 bytes at a time. The output
+// is written into a buffer that already has the full decoded size, and decoding stops once it is full. The input can
+// be split over several spans, which are read in place.
+class Inflate final
+{
+public:
+	// A part of the input, streams can be split at any byte (such as over the IDAT chunks of a PNG file)
+	struct Span final
+	{
+	public:
+		const uint8_t* data;
+		size_t size;
+	}; // struct Span
+
+	// Decodes a zlib (RFC 1950) stream, or a raw deflate stream if zlibHeader is false, into out. Returns false if the
+	// stream is corrupt, otherwise sets the number of bytes written, which is less than outSize if the stream ended.
+	// The adler32 checksum is not checked, same as stb_image.
+	static bool Decode(const Span* spans, size_t spanCount, uint8_t* out, size_t outSize, bool zlibHeader,
+		size_t* written);
+	// Decodes a stream from a single buffer
+	inline static bool Decode(const uint8_t* in, size_t inSize, uint8_t* out, size_t outSize, bool zlibHeader,
+		size_t* written) {
+		const Span span{ in, inSize };
+		return Decode(&span, 1, out, outSize, zlibHeader, written);
+	}
+}; // class Inflate
@@ -0,0 +1,317 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#include "./JpegKernels.hpp"
+
+#include "../util/CpuFeatures.hpp"
+
+#include <cstring>
+
+#include <immintrin.h>
+
+
+// The fixed point YCbCr to RGB factors, matching the stb_image reduced precision conversion
+static constexpr int16_t CR_R{ int16_t(1.40200f * 4096.0f + 0.5f) };
+static constexpr int16_t CR_G{ int16_t(-int16_t(0.71414f * 4096.0f + 0.5f)) };
+static constexpr int16_t CB_G{ int16_t(-int16_t(0.34414f * 4096.0f + 0.5f)) };
+static constexpr int16_t CB_B{ int16_t(1.77200f * 4096.0f + 0.5f) };
+
+// The fixed point IDCT factors, matching stb_image
+static constexpr int32_t F2F(float x) { return int32_t(double(x * 4096) + 0.5); }
+
+
+// ====================================================================================================================
+// A 16-bit pair constant for the IDCT rotations, x for the even elements and y for the odd elements
+VEGA_TARGET_AVX2 static inline __m256i IdctConst(int32_t x, int32_t y)
+{
+	return _mm256_set1_epi32(int32_t(uint32_t(uint16_t(x)) | (uint32_t(uint16_t(y)) << 16)));
+}
+
+// ====================================================================================================================
+// Multiplies the interleaved 16-bit pairs of x and y with the pairs of two constants, giving 8 32-bit results each
+VEGA_TARGET_AVX2 static inline void IdctRotate(__m128i x, __m128i y, __m256i c0, __m256i c1, __m256i* out0,
+	__m256i* out1)
+{
+	const auto xy = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpacklo_epi16(x, y)),
+		_mm_unpackhi_epi16(x, y), 1);
+	*out0 = _mm256_madd_epi16(xy, c0);
+	*out1 = _mm256_madd_epi16(xy, c1);
+}
+
+// ====================================================================================================================
+// Widens to 32-bit, scaled by 4096
+VEGA_TARGET_AVX2 static inline __m256i IdctWiden(__m128i in)
+{
+	return _mm256_slli_epi32(_mm256_cvtepi16_epi32(in), 12);
+}
+
+// ====================================================================================================================
+// Butterfly of a and b with the bias added to a, then descales and packs the sum and difference to 16-bit
+template<int Shift>
+VEGA_TARGET_AVX2 static inline void IdctButterfly(__m256i a, __m256i b, __m256i bias, __m128i* out0, __m128i* out1)
+{
+	const auto biased = _mm256_add_epi32(a, bias);
+	const auto sum = _mm256_srai_epi32(_mm256_add_epi32(biased, b), Shift);
+	const auto dif = _mm256_srai_epi32(_mm256_sub_epi32(biased, b), Shift);
+	const auto packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(sum, dif), 0xD8);
+	*out0 = _mm256_castsi256_si128(packed);
+	*out1 = _mm256_extracti128_si256(packed, 1);
+}
+
+// ====================================================================================================================
+// One 1D pass of the IDCT over the 8 rows, with the same operations as the stb_image SSE2 IDCT, but with the 32-bit
+// intermediates for all 8 columns in a single register
+template<int Shift>
+VEGA_TARGET_AVX2 static inline void IdctPass(__m128i row[8], __m256i bias)
+{
+	const auto rot0_0 = IdctConst(F2F(0.5411961f), F2F(0.5411961f) + F2F(-1.847759065f));
+	const auto rot0_1 = IdctConst(F2F(0.5411961f) + F2F(0.765366865f), F2F(0.5411961f));
+	const auto rot1_0 = IdctConst(F2F(1.175875602f) + F2F(-0.899976223f), F2F(1.175875602f));
+	const auto rot1_1 = IdctConst(F2F(1.175875602f), F2F(1.175875602f) + F2F(-2.562915447f));
+	const auto rot2_0 = IdctConst(F2F(-1.961570560f) + F2F(0.298631336f), F2F(-1.961570560f));
+	const auto rot2_1 = IdctConst(F2F(-1.961570560f), F2F(-1.961570560f) + F2F(3.072711026f));
+	const auto rot3_0 = IdctConst(F2F(-0.390180644f) + F2F(2.053119869f), F2F(-0.390180644f));
+	const auto rot3_1 = IdctConst(F2F(-0.390180644f), F2F(-0.390180644f) + F2F(1.501321110f));
+
+	// Even part
+	__m256i t2e, t3e;
+	IdctRotate(row[2], row[6], rot0_0, rot0_1, &t2e, &t3e);
+	const auto t0e = IdctWiden(_mm_add_epi16(row[0], row[4]));
+	const auto t1e = IdctWiden(_mm_sub_epi16(row[0], row[4]));
+	const auto x0 = _mm256_add_epi32(t0e, t3e);
+	const auto x3 = _mm256_sub_epi32(t0e, t3e);
+	const auto x1 = _mm256_add_epi32(t1e, t2e);
+	const auto x2 = _mm256_sub_epi32(t1e, t2e);
+
+	// Odd part
+	__m256i y0o, y1o, y2o, y3o, y4o, y5o;
+	IdctRotate(row[7], row[3], rot2_0, rot2_1, &y0o, &y2o);
+	IdctRotate(row[5], row[1], rot3_0, rot3_1, &y1o, &y3o);
+	IdctRotate(_mm_add_epi16(row[1], row[7]), _mm_add_epi16(row[3], row[5]), rot1_0, rot1_1, &y4o, &y5o);
+	const auto x4 = _mm256_add_epi32(y0o, y4o);
+	const auto x5 = _mm256_add_epi32(y1o, y5o);
+	const auto x6 = _mm256_add_epi32(y2o, y5o);
+	const auto x7 = _mm256_add_epi32(y3o, y4o);
+
+	IdctButterfly<Shift>(x0, x7, bias, &row[0], &row[7]);
+	IdctButterfly<Shift>(x1, x6, bias, &row[1], &row[6]);
+	IdctButterfly<Shift>(x2, x5, bias, &row[2], &row[5]);
+	IdctButterfly<Shift>(x3, x4, bias, &row[3], &row[4]);
+}
+
+// ====================================================================================================================
+// Interleave step of the 8x8 transposes
+VEGA_TARGET_AVX2 static inline void Interleave16(__m128i& a, __m128i& b)
+{
+	const auto tmp = a;
+	a = _mm_unpacklo_epi16(a, b);
+	b = _mm_unpackhi_epi16(tmp, b);
+}
+VEGA_TARGET_AVX2 static inline void Interleave8(__m128i& a, __m128i& b)
+{
+	const auto tmp = a;
+	a = _mm_unpacklo_epi8(a, b);
+	b = _mm_unpackhi_epi8(tmp, b);
+}
+
+// ====================================================================================================================
+VEGA_TARGET_AVX2 void JpegKernels::IdctAvx2(uint8_t* out, int stride, short data[64])
+{
+	__m128i row[8];
+	for (uint32_t i = 0; i < 8; ++i) {
+		row[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(data + (i * 8)));
+	}
+
+	// Column pass, with the rounding bias of the stb_image IDCT
+	IdctPass<10>(row, _mm256_set1_epi32(512));
+
+	// 16-bit transpose
+	Interleave16(row[0], row[4]);
+	Interleave16(row[1], row[5]);
+	Interleave16(row[2], row[6]);
+	Interleave16(row[3], row[7]);
+	Interleave16(row[0], row[2]);
+	Interleave16(row[1], row[3]);
+	Interleave16(row[4], row[6]);
+	Interleave16(row[5], row[7]);
+	Interleave16(row[0], row[1]);
+	Interleave16(row[2], row[3]);
+	Interleave16(row[4], row[5]);
+	Interleave16(row[6], row[7]);
+
+	// Row pass, with the rounding bias and the +128 level shift folded together
+	IdctPass<17>(row, _mm256_set1_epi32(65536 + (128 << 17)));
+
+	// Pack to bytes and transpose back
+	auto p0 = _mm_packus_epi16(row[0], row[1]);
+	auto p1 = _mm_packus_epi16(row[2], row[3]);
+	auto p2 = _mm_packus_epi16(row[4], row[5]);
+	auto p3 = _mm_packus_epi16(row[6], row[7]);
+	Interleave8(p0, p2);
+	Interleave8(p1, p3);
+	Interleave8(p0, p1);
+	Interleave8(p2, p3);
+	Interleave8(p0, p2);
+	Interleave8(p1, p3);
+
+	const __m128i rows[4]{ p0, p2, p1, p3 };
+	for (uint32_t i = 0; i < 4; ++i, out += 2 * stride) {
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(out), rows[i]);
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(out + stride), _mm_shuffle_epi32(rows[i], 0x4E));
+	}
+}
+
+// ====================================================================================================================
+VEGA_TARGET_AVX2 void JpegKernels::YCbCrToRgbAvx2(uint8_t* out, const uint8_t* y, const uint8_t* cb, const uint8_t* cr,
+	int count, int step)
+{
+	int i = 0;
+	if ((step == 3) || (step == 4)) {
+		const auto crConst0 = _mm256_set1_epi16(CR_R);
+		const auto crConst1 = _mm256_set1_epi16(CR_G);
+		const auto cbConst0 = _mm256_set1_epi16(CB_G);
+		const auto cbConst1 = _mm256_set1_epi16(CB_B);
+		const auto bias = _mm256_set1_epi16(128);
+		const auto round = _mm256_set1_epi16(8);
+		const auto alpha = _mm256_set1_epi16(255);
+		const auto dropAlpha = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+			0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+
+		for (; (i + 15) < count; i += 16, out += 16 * step) {
+			// Y is scaled by 16 with the rounding bias, Cb and Cr are biased to signed and scaled by 256
+			const auto yw = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i)));
+			const auto cbw = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cb + i)));
+			const auto crw = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cr + i)));
+			const auto yws = _mm256_add_epi16(_mm256_slli_epi16(yw, 4), round);
+			const auto cbs = _mm256_slli_epi16(_mm256_sub_epi16(cbw, bias), 8);
+			const auto crs = _mm256_slli_epi16(_mm256_sub_epi16(crw, bias), 8);
+
+			// Color transform
+			const auto rws = _mm256_add_epi16(_mm256_mulhi_epi16(crConst0, crs), yws);
+			const auto gws = _mm256_add_epi16(_mm256_add_epi16(_mm256_mulhi_epi16(cbConst0, cbs), yws),
+				_mm256_mulhi_epi16(crs, crConst1));
+			const auto bws = _mm256_add_epi16(yws, _mm256_mulhi_epi16(cbs, cbConst1));
+
+			// Descale and interleave, each lane holds 8 pixels (0-7 and 8-15)
+			const auto brb = _mm256_packus_epi16(_mm256_srai_epi16(rws, 4), _mm256_srai_epi16(bws, 4));
+			const auto gxb = _mm256_packus_epi16(_mm256_srai_epi16(gws, 4), alpha);
+			const auto t0 = _mm256_unpacklo_epi8(brb, gxb);
+			const auto t1 = _mm256_unpackhi_epi8(brb, gxb);
+			const auto o0 = _mm256_unpacklo_epi16(t0, t1); // Pixels 0-3 and 8-11
+			const auto o1 = _mm256_unpackhi_epi16(t0, t1); // Pixels 4-7 and 12-15
+
+			if (step == 4) {
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_permute2x128_si256(o0, o1, 0x20));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 32), _mm256_permute2x128_si256(o0, o1, 0x31));
+			}
+			else {
+				// Each store overwrites the 4 unused bytes of the previous store, and the last store is exact
+				const auto c0 = _mm256_shuffle_epi8(o0, dropAlpha);
+				const auto c1 = _mm256_shuffle_epi8(o1, dropAlpha);
+				const auto last = _mm256_extracti128_si256(c1, 1);
+				const int32_t lastBits = _mm_cvtsi128_si32(_mm_srli_si128(last, 8));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm256_castsi256_si128(c0));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 12), _mm256_castsi256_si128(c1));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 24), _mm256_extracti128_si256(c0, 1));
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(out + 36), last);
+				std::memcpy(out + 44, &lastBits, 4);
+			}
+		}
+	}
+
+	// Remaining pixels, with the stb_image scalar conversion (which writes alpha even for 3 channels)
+	for (; i < count; ++i, out += step) {
+		const int32_t yFixed = (int32_t(y[i]) << 20) + (1 << 19);
+		const int32_t crv = int32_t(cr[i]) - 128;
+		const int32_t cbv = int32_t(cb[i]) - 128;
+		int32_t r = (yFixed + (crv * (CR_R * 256))) >> 20;
+		int32_t g = (yFixed + (crv * (CR_G * 256)) + ((cbv * (CB_G * 256)) & ~0xFFFF)) >> 20;
+		int32_t b = (yFixed + (cbv * (CB_B * 256))) >> 20;
+		out[0] = uint8_t((r < 0) ? 0 : (r > 255) ? 255 : r);
+		out[1] = uint8_t((g < 0) ? 0 : (g > 255) ? 255 : g);
+		out[2] = uint8_t((b < 0) ? 0 : (b > 255) ? 255 : b);
+		out[3] = 255;
+	}
+}
+
+// ====================================================================================================================
+VEGA_TARGET_AVX2 uint8_t* JpegKernels::ResampleH2Avx2(uint8_t* out, uint8_t* inNear, uint8_t*, int w, int)
+{
+	const uint8_t* const in = inNear;
+	if (w == 1) {
+		out[0] = out[1] = in[0];
+		return out;
+	}
+
+	out[0] = in[0];
+	out[1] = uint8_t((in[0] * 3 + in[1] + 2) >> 2);
+
+	// Groups of 16 interior pixels: even outputs are (3 * cur + prev + 2) / 4 and odd are (3 * cur + next + 2) / 4
+	int i = 1;
+	const auto two = _mm256_set1_epi16(2);
+	for (; (i + 17) <= w; i += 16) {
+		const auto prev = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i - 1)));
+		const auto curr = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+		const auto next = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 1)));
+		const auto n = _mm256_add_epi16(_mm256_add_epi16(_mm256_slli_epi16(curr, 1), curr), two);
+		const auto even = _mm256_srli_epi16(_mm256_add_epi16(n, prev), 2);
+		const auto odd = _mm256_srli_epi16(_mm256_add_epi16(n, next), 2);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 2), _mm256_or_si256(even, _mm256_slli_epi16(odd, 8)));
+	}
+	for (; i < (w - 1); ++i) {
+		const int n = 3 * in[i] + 2;
+		out[i * 2 + 0] = uint8_t((n + in[i - 1]) >> 2);
+		out[i * 2 + 1] = uint8_t((n + in[i + 1]) >> 2);
+	}
+	out[i * 2 + 0] = uint8_t((in[w - 2] * 3 + in[w - 1] + 2) >> 2);
+	out[i * 2 + 1] = in[w - 1];
+	return out;
+}
+
+// ====================================================================================================================
+VEGA_TARGET_AVX2 uint8_t* JpegKernels::ResampleHV2Avx2(uint8_t* out, uint8_t* inNear, uint8_t* inFar, int w, int)
+{
+	if (w == 1) {
+		out[0] = out[1] = uint8_t((3 * inNear[0] + inFar[0] + 2) >> 2);
+		return out;
+	}
+
+	// Groups of 16 pixels, not including the last pixel, which needs the filter boundary conditions
+	int i = 0, t0, t1 = 3 * inNear[0] + inFar[0];
+	const auto bias = _mm256_set1_epi16(8);
+	for (; i < ((w - 1) & ~15); i += 16) {
+		// Vertical pass, as 4 * near + (far - near)
+		const auto farw = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(inFar + i)));
+		const auto nearw = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(inNear + i)));
+		const auto curr = _mm256_add_epi16(_mm256_slli_epi16(nearw, 2), _mm256_sub_epi16(farw, nearw));
+
+		// The row shifted by one pixel each way across the lanes, with the neighboring pixels inserted at the ends
+		const auto prv0 = _mm256_alignr_epi8(curr, _mm256_permute2x128_si256(curr, curr, 0x08), 14);
+		const auto nxt0 = _mm256_alignr_epi8(_mm256_permute2x128_si256(curr, curr, 0x81), curr, 2);
+		const auto prev = _mm256_insert_epi16(prv0, int16_t(t1), 0);
+		const auto next = _mm256_insert_epi16(nxt0, int16_t(3 * inNear[i + 16] + inFar[i + 16]), 15);
+
+		// Horizontal pass, even pixels are 3 * cur + prev and odd pixels are 3 * cur + next
+		const auto curb = _mm256_add_epi16(_mm256_slli_epi16(curr, 2), bias);
+		const auto even = _mm256_srli_epi16(_mm256_add_epi16(_mm256_sub_epi16(prev, curr), curb), 4);
+		const auto odd = _mm256_srli_epi16(_mm256_add_epi16(_mm256_sub_epi16(next, curr), curb), 4);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 2), _mm256_or_si256(even, _mm256_slli_epi16(odd, 8)));
+
+		t1 = 3 * inNear[i + 15] + inFar[i + 15];
+	}
+
+	t0 = t1;
+	t1 = 3 * inNear[i] + inFar[i];
+	out[i * 2] = uint8_t((3 * t1 + t0 + 8) >> 4);
+	for (++i; i < w; ++i) {
+		t0 = t1;
+		t1 = 3 * inNear[i] + inFar[i];
+		out[i * 2 - 1] = uint8_t((3 * t0 + t1 + 8) >> 4);
+		out[i * 2] = uint8_t((3 * t1 + t0 + 8) >> 4);
+	}
+	out[w * 2 - 1] = uint8_t((t1 + 2) >> 2);
+	return out;
+}
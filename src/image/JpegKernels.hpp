@@ -0,0 +1,26 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include "../config.hpp"
+
+
+// AVX2 versions of the stb_image JPEG kernels, which are selected at runtime when the CPU supports AVX2
+// Each kernel has the same signature and exactly the same results as the stb_image kernel that it replaces.
+class JpegKernels final
+{
+public:
+	// Inverse DCT of one 8x8 block of dequantized coefficients into 8-bit samples
+	static void IdctAvx2(uint8_t* out, int stride, short data[64]);
+	// Converts a row of YCbCr samples to RGB(A), with 'step' (3 or 4) bytes per output pixel
+	static void YCbCrToRgbAvx2(uint8_t* out, const uint8_t* y, const uint8_t* cb, const uint8_t* cr, int count,
+		int step);
+	// Upsamples a chroma row 2x horizontally (h2v1)
+	static uint8_t* ResampleH2Avx2(uint8_t* out, uint8_t* inNear, uint8_t* inFar, int w, int hs);
+	// Upsamples a chroma row 2x horizontally and vertically (h2v2)
+	static uint8_t* ResampleHV2Avx2(uint8_t* out, uint8_t* inNear, uint8_t* inFar, int w, int hs);
+}; // class JpegKernels
@@ -0,0 +1,466 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#include "./MipGenerator.hpp"
+
+#include "../util/ThreadPool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include <emmintrin.h>
+
+
+// Kaiser filter shape (same as the NVIDIA texture tools defaults), the radius is in destination pixels
+static constexpr double KAISER_RADIUS{ 3.0 };
+static constexpr double KAISER_ALPHA{ 4.0 };
+// The rows of each level filtered by a single task
+static constexpr uint32_t BAND_ROWS{ 32 };
+// The resolution of the float to 8-bit encoding tables
+static constexpr uint32_t ENCODE_STEPS{ 65536 };
+
+// Conversions between 8-bit values and linear floats
+struct ValueTables final
+{
+public:
+	float linearDecode[256];
+	float srgbDecode[256];
+	uint8_t linearEncode[ENCODE_STEPS];
+	uint8_t srgbEncode[ENCODE_STEPS];
+}; // struct ValueTables
+
+// The source pixels and weights that make up each destination pixel along one axis, the taps past the edges are
+// folded into the edge pixels so that each destination pixel uses a contiguous range of source pixels
+struct AxisWeights final
+{
+public:
+	std::vector<uint32_t> first;
+	std::vector<uint32_t> count;
+	std::vector<uint32_t> offset;	// The first weight of each destination pixel
+	std::vector<float> weights;
+}; // struct AxisWeights
+
+// A level to filter from the level above it
+struct LevelJob final
+{
+public:
+	const uint8_t* src;
+	uint32_t srcWidth;
+	uint32_t srcHeight;
+	uint8_t* dst;
+	uint32_t dstWidth;
+	uint32_t dstHeight;
+	uint32_t channels;
+	const float* decode[4];			// The decode table for each channel
+	const uint8_t* encode[4];		// The encode table for each channel
+	bool srgb[4];					// If each channel is sRGB encoded
+	const AxisWeights* horizontal;
+	const AxisWeights* vertical;
+}; // struct LevelJob
+
+
+// ====================================================================================================================
+static const ValueTables& Tables()
+{
+	struct Builder final
+	{
+	public:
+		Builder() : tables{ } {
+			for (uint32_t i = 0; i < 256; ++i) {
+				const double value = i / 255.0;
+				tables.linearDecode[i] = float(value);
+				tables.srgbDecode[i] = float((value <= 0.04045) ? (value / 12.92) : std::pow((value + 0.055) / 1.055, 2.4));
+			}
+			for (uint32_t i = 0; i < ENCODE_STEPS; ++i) {
+				const double value = double(i) / (ENCODE_STEPS - 1);
+				const double srgb = (value <= 0.0031308) ? (value * 12.92) : ((1.055 * std::pow(value, 1 / 2.4)) - 0.055);
+				tables.linearEncode[i] = uint8_t((value * 255) + 0.5);
+				tables.srgbEncode[i] = uint8_t((srgb * 255) + 0.5);
+			}
+		}
+		ValueTables tables;
+	}; // struct Builder
+
+	static const Builder builder{ };
+	return builder.tables;
+}
+
+// ====================================================================================================================
+static inline uint8_t Encode(const uint8_t* table, float value)
+{
+	value = std::min(std::max(value, 0.0f), 1.0f);
+	return table[uint32_t((value * (ENCODE_STEPS - 1)) + 0.5f)];
+}
+
+// ====================================================================================================================
+// Modified Bessel function of the first kind, order zero
+static double BesselI0(double x)
+{
+	double sum = 1, term = 1;
+	for (uint32_t k = 1; term > (sum * 1e-12); ++k) {
+		const double factor = x / (2 * k);
+		term *= factor * factor;
+		sum += term;
+	}
+	return sum;
+}
+
+// ====================================================================================================================
+// The Kaiser windowed sinc, with t in destination pixels
+static double Kaiser(double t)
+{
+	if (std::abs(t) >= KAISER_RADIUS) {
+		return 0;
+	}
+	const double pt = 3.14159265358979323846 * t;
+	const double sinc = (t == 0) ? 1 : (std::sin(pt) / pt);
+	const double ratio = t / KAISER_RADIUS;
+	return sinc * BesselI0(KAISER_ALPHA * std::sqrt(1 - (ratio * ratio))) / BesselI0(KAISER_ALPHA);
+}
+
+// ====================================================================================================================
+static void BuildWeights(uint32_t srcSize, uint32_t dstSize, ImageMipFilter filter, AxisWeights* axis)
+{
+	const double scale = double(srcSize) / dstSize;
+	std::vector<double> taps{ };
+	axis->first.resize(dstSize);
+	axis->count.resize(dstSize);
+	axis->offset.resize(dstSize);
+	axis->weights.clear();
+	for (uint32_t di = 0; di < dstSize; ++di) {
+		// The source pixels in the filter support, with the taps past the edges folded into the edge pixels
+		int64_t low, high;
+		double start = 0, end = 0, center = 0;
+		if (filter == ImageMipFilter::BOX) {
+			start = di * scale;
+			end = (di + 1) * scale;
+			low = int64_t(std::floor(start));
+			high = int64_t(std::ceil(end)) - 1;
+		}
+		else {
+			center = (di + 0.5) * scale;
+			const double support = KAISER_RADIUS * scale;
+			low = int64_t(std::floor(center - support));
+			high = int64_t(std::ceil(center + support));
+		}
+		const int64_t lastSrc = int64_t(srcSize) - 1;
+		const uint32_t base = uint32_t(std::min(std::max<int64_t>(low, 0), lastSrc));
+		const uint32_t top = uint32_t(std::min(std::max<int64_t>(high, 0), lastSrc));
+		taps.assign(top - base + 1, 0.0);
+		for (int64_t si = low; si <= high; ++si) {
+			const size_t tap = size_t(std::min(std::max<int64_t>(si, 0), lastSrc) - base);
+			if (filter == ImageMipFilter::BOX) {
+				// Area of the source pixel covered by the destination pixel
+				taps[tap] += std::max(std::min(end, double(si + 1)) - std::max(start, double(si)), 0.0);
+			}
+			else {
+				taps[tap] += Kaiser(((si + 0.5) - center) / scale);
+			}
+		}
+
+		// Trim the unused taps, and normalize the rest
+		uint32_t first = 0, last = uint32_t(taps.size()) - 1;
+		while ((first < last) && (taps[first] == 0)) {
+			++first;
+		}
+		while ((last > first) && (taps[last] == 0)) {
+			--last;
+		}
+		double sum = 0;
+		for (uint32_t ti = first; ti <= last; ++ti) {
+			sum += taps[ti];
+		}
+		axis->first[di] = base + first;
+		axis->count[di] = last - first + 1;
+		axis->offset[di] = uint32_t(axis->weights.size());
+		for (uint32_t ti = first; ti <= last; ++ti) {
+			axis->weights.push_back(float(taps[ti] / sum));
+		}
+	}
+}
+
+// ====================================================================================================================
+// Filters a row of linear values horizontally
+template<uint32_t Channels>
+static void FilterRow(const float* src, const AxisWeights& axis, uint32_t dstWidth, float* dst)
+{
+	for (uint32_t dx = 0; dx < dstWidth; ++dx, dst += Channels) {
+		const float* const weights = axis.weights.data() + axis.offset[dx];
+		const float* pixel = src + (size_t(axis.first[dx]) * Channels);
+		float sum[Channels]{ };
+		for (uint32_t ti = 0; ti < axis.count[dx]; ++ti, pixel += Channels) {
+			for (uint32_t ch = 0; ch < Channels; ++ch) {
+				sum[ch] += weights[ti] * pixel[ch];
+			}
+		}
+		for (uint32_t ch = 0; ch < Channels; ++ch) {
+			dst[ch] = sum[ch];
+		}
+	}
+}
+
+// ====================================================================================================================
+template<>
+void FilterRow<4>(const float* src, const AxisWeights& axis, uint32_t dstWidth, float* dst)
+{
+	for (uint32_t dx = 0; dx < dstWidth; ++dx, dst += 4) {
+		const float* const weights = axis.weights.data() + axis.offset[dx];
+		const float* pixel = src + (size_t(axis.first[dx]) * 4);
+		__m128 sum = _mm_setzero_ps();
+		for (uint32_t ti = 0; ti < axis.count[dx]; ++ti, pixel += 4) {
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[ti]), _mm_loadu_ps(pixel)));
+		}
+		_mm_storeu_ps(dst, sum);
+	}
+}
+
+// ====================================================================================================================
+// Filters a band of rows of a level with the separated weights
+template<uint32_t Channels>
+static void FilterBand(const LevelJob& job, uint32_t y0, uint32_t y1)
+{
+	const AxisWeights& vertical = *job.vertical;
+	const uint32_t srcFirst = vertical.first[y0];
+	const uint32_t srcEnd = vertical.first[y1 - 1] + vertical.count[y1 - 1];
+	const size_t srcRowSize = size_t(job.srcWidth) * Channels;
+	const size_t dstRowSize = size_t(job.dstWidth) * Channels;
+
+	// Decode and horizontally filter each source row used by the band
+	std::vector<float> linear(srcRowSize);
+	std::vector<float> rows((srcEnd - srcFirst) * dstRowSize);
+	for (uint32_t sy = srcFirst; sy < srcEnd; ++sy) {
+		const uint8_t* src = job.src + (sy * srcRowSize);
+		for (size_t i = 0; i < srcRowSize; i += Channels) {
+			for (uint32_t ch = 0; ch < Channels; ++ch) {
+				linear[i + ch] = job.decode[ch][src[i + ch]];
+			}
+		}
+		FilterRow<Channels>(linear.data(), *job.horizontal, job.dstWidth, rows.data() + ((sy - srcFirst) * dstRowSize));
+	}
+
+	// Vertically filter and encode each destination row
+	std::vector<float> sum(dstRowSize);
+	for (uint32_t dy = y0; dy < y1; ++dy) {
+		const float* const weights = vertical.weights.data() + vertical.offset[dy];
+		const float* const firstRow = rows.data() + ((vertical.first[dy] - srcFirst) * dstRowSize);
+		size_t i = 0;
+		for (; (i + 4) <= dstRowSize; i += 4) {
+			__m128 acc = _mm_setzero_ps();
+			for (uint32_t ti = 0; ti < vertical.count[dy]; ++ti) {
+				const auto value = _mm_loadu_ps(firstRow + (ti * dstRowSize) + i);
+				acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(weights[ti]), value));
+			}
+			_mm_storeu_ps(sum.data() + i, acc);
+		}
+		for (; i < dstRowSize; ++i) {
+			float acc = 0;
+			for (uint32_t ti = 0; ti < vertical.count[dy]; ++ti) {
+				acc += weights[ti] * firstRow[(ti * dstRowSize) + i];
+			}
+			sum[i] = acc;
+		}
+
+		uint8_t* const dst = job.dst + (dy * dstRowSize);
+		for (size_t px = 0; px < dstRowSize; px += Channels) {
+			for (uint32_t ch = 0; ch < Channels; ++ch) {
+				dst[px + ch] = Encode(job.encode[ch], sum[px + ch]);
+			}
+		}
+	}
+}
+
+// ====================================================================================================================
+// Averages the 2x2 blocks of a band of rows, for levels with even sizes
+template<uint32_t Channels>
+static void BoxBand(const LevelJob& job, uint32_t y0, uint32_t y1)
+{
+	const size_t srcRowSize = size_t(job.srcWidth) * Channels;
+	const size_t dstRowSize = size_t(job.dstWidth) * Channels;
+	for (uint32_t dy = y0; dy < y1; ++dy) {
+		const uint8_t* const row0 = job.src + ((2 * dy) * srcRowSize);
+		const uint8_t* const row1 = row0 + srcRowSize;
+		uint8_t* const dst = job.dst + (dy * dstRowSize);
+		uint32_t dx = 0;
+		if ((Channels == 4) && !job.srgb[0]) {
+			// Four pixels at a time, the channel sums fit in 16 bits
+			const auto zero = _mm_setzero_si128();
+			const auto round = _mm_set1_epi16(2);
+			for (; (dx + 4) <= job.dstWidth; dx += 4) {
+				const auto a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + (8 * dx)));
+				const auto a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + (8 * dx) + 16));
+				const auto b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + (8 * dx)));
+				const auto b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + (8 * dx) + 16));
+				const auto s0 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero));
+				const auto s1 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+				const auto s2 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero));
+				const auto s3 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+				auto p01 = _mm_add_epi16(_mm_unpacklo_epi64(s0, s1), _mm_unpackhi_epi64(s0, s1));
+				auto p23 = _mm_add_epi16(_mm_unpacklo_epi64(s2, s3), _mm_unpackhi_epi64(s2, s3));
+				p01 = _mm_srli_epi16(_mm_add_epi16(p01, round), 2);
+				p23 = _mm_srli_epi16(_mm_add_epi16(p23, round), 2);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + (4 * dx)), _mm_packus_epi16(p01, p23));
+			}
+		}
+		for (; dx < job.dstWidth; ++dx) {
+			const uint8_t* const p0 = row0 + ((2 * dx) * Channels);
+			const uint8_t* const p1 = row1 + ((2 * dx) * Channels);
+			for (uint32_t ch = 0; ch < Channels; ++ch) {
+				if (job.srgb[ch]) {
+					const float* const decode = job.decode[ch];
+					const float sum = decode[p0[ch]] + decode[p0[ch + Channels]] + decode[p1[ch]] +
+						decode[p1[ch + Channels]];
+					dst[(dx * Channels) + ch] = Encode(job.encode[ch], sum * 0.25f);
+				}
+				else {
+					const uint32_t sum = p0[ch] + p0[ch + Channels] + p1[ch] + p1[ch + Channels];
+					dst[(dx * Channels) + ch] = uint8_t((sum + 2) >> 2);
+				}
+			}
+		}
+	}
+}
+
+// ====================================================================================================================
+template<uint32_t Channels>
+static void RunLevel(const LevelJob& job)
+{
+	const bool box = !job.horizontal;
+	const size_t bands = (job.dstHeight + BAND_ROWS - 1) / BAND_ROWS;
+	ThreadPool::Shared().parallelFor(bands, [&job, box](size_t band) {
+		const uint32_t y0 = uint32_t(band * BAND_ROWS);
+		const uint32_t y1 = std::min(y0 + BAND_ROWS, job.dstHeight);
+		if (box) {
+			BoxBand<Channels>(job, y0, y1);
+		}
+		else {
+			FilterBand<Channels>(job, y0, y1);
+		}
+	});
+}
+
+// ====================================================================================================================
+// Scales alpha in a level so that the fraction of alpha values at or above the cutoff matches the full size image
+// The threshold T is chosen so the count of alpha >= T is closest to the target, and the scale maps T to the cutoff.
+static void ScaleAlphaCoverage(uint8_t* level, size_t pixels, uint32_t channels, uint32_t cutoff, double coverage)
+{
+	uint8_t* const alpha = level + (channels - 1);
+	size_t histogram[256]{ };
+	for (size_t i = 0; i < pixels; ++i) {
+		++histogram[alpha[i * channels]];
+	}
+	const double target = coverage * double(pixels);
+	size_t above = 0;
+	uint32_t threshold = cutoff;
+	double best = -1;
+	for (uint32_t t = 255; t >= 1; --t) {
+		above += histogram[t];
+		const double error = std::abs(double(above) - target);
+		if ((best < 0) || (error < best)) {
+			best = error;
+			threshold = t;
+		}
+	}
+	if (threshold == cutoff) {
+		return;
+	}
+
+	// Rounded to nearest, values from the threshold up reach the cutoff and values below it do not
+	const double scale = (cutoff - 0.5) / (threshold - 0.5);
+	for (size_t i = 0; i < pixels; ++i) {
+		uint8_t& value = alpha[i * channels];
+		value = uint8_t(std::min((value * scale) + 0.5, 255.0));
+	}
+}
+
+// ====================================================================================================================
+uint32_t MipGenerator::LevelCount(uint32_t width, uint32_t height)
+{
+	uint32_t levels = 1;
+	for (uint32_t size = std::max(width, height); size > 1; size >>= 1) {
+		++levels;
+	}
+	return levels;
+}
+
+// ====================================================================================================================
+size_t MipGenerator::Layout(uint32_t width, uint32_t height, uint32_t channels, size_t* offsets)
+{
+	const uint32_t levels = LevelCount(width, height);
+	size_t size = 0;
+	for (uint32_t li = 0; li < levels; ++li) {
+		offsets[li] = size;
+		size += size_t(std::max(width >> li, 1u)) * std::max(height >> li, 1u) * channels;
+	}
+	return size;
+}
+
+// ====================================================================================================================
+void MipGenerator::Generate(const uint8_t* src, uint32_t width, uint32_t height, uint32_t channels,
+	const ImageMipOptions& options, uint8_t* dst)
+{
+	size_t offsets[ImageMipChain::MAX_LEVELS];
+	const uint32_t levels = LevelCount(width, height);
+	Layout(width, height, channels, offsets);
+	std::memcpy(dst, src, size_t(width) * height * channels);
+
+	// Alpha is always linear, and gray with alpha is treated the same as color with alpha
+	const auto& tables = Tables();
+	const bool hasAlpha = (channels == 2) || (channels == 4);
+	LevelJob job{ };
+	job.channels = channels;
+	for (uint32_t ch = 0; ch < channels; ++ch) {
+		const bool srgb = options.srgb && !(hasAlpha && (ch == (channels - 1)));
+		job.srgb[ch] = srgb;
+		job.decode[ch] = srgb ? tables.srgbDecode : tables.linearDecode;
+		job.encode[ch] = srgb ? tables.srgbEncode : tables.linearEncode;
+	}
+
+	AxisWeights horizontal{ }, vertical{ };
+	for (uint32_t li = 1; li < levels; ++li) {
+		job.src = dst + offsets[li - 1];
+		job.srcWidth = std::max(width >> (li - 1), 1u);
+		job.srcHeight = std::max(height >> (li - 1), 1u);
+		job.dst = dst + offsets[li];
+		job.dstWidth = std::max(width >> li, 1u);
+		job.dstHeight = std::max(height >> li, 1u);
+
+		// Box filtered levels with even sizes are averaged directly
+		const bool even = ((job.srcWidth % 2) == 0) && ((job.srcHeight % 2) == 0);
+		if ((options.filter == ImageMipFilter::BOX) && even) {
+			job.horizontal = job.vertical = nullptr;
+		}
+		else {
+			BuildWeights(job.srcWidth, job.dstWidth, options.filter, &horizontal);
+			BuildWeights(job.srcHeight, job.dstHeight, options.filter, &vertical);
+			job.horizontal = &horizontal;
+			job.vertical = &vertical;
+		}
+
+		switch (channels) {
+			case 1: RunLevel<1>(job); break;
+			case 2: RunLevel<2>(job); break;
+			case 3: RunLevel<3>(job); break;
+			case 4: RunLevel<4>(job); break;
+		}
+	}
+
+	// Alpha coverage is adjusted after the chain is built, so that each level is filtered from unscaled alpha
+	if (hasAlpha && (options.alphaCutoff > 0) && (options.alphaCutoff < 1)) {
+		const uint32_t cutoff = std::max(uint32_t(std::ceil(options.alphaCutoff * 255)), 1u);
+		const size_t pixels = size_t(width) * height;
+		size_t covered = 0;
+		for (size_t i = 0; i < pixels; ++i) {
+			covered += (src[(i * channels) + (channels - 1)] >= cutoff) ? 1 : 0;
+		}
+		const double coverage = double(covered) / double(pixels);
+		for (uint32_t li = 1; li < levels; ++li) {
+			const size_t levelPixels = size_t(std::max(width >> li, 1u)) * std::max(height >> li, 1u);
+			ScaleAlphaCoverage(dst + offsets[li], levelPixels, channels, cutoff, coverage);
+		}
+	}
+}
@@ -0,0 +1,58 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include "../config.hpp"
+
+
+// The filters used to reduce each mip level from the level above it
+enum class ImageMipFilter : uint32_t
+{
+	BOX = 0,		// Average of each 2x2 block (area weighted for odd sizes)
+	KAISER = 1,		// Kaiser windowed sinc, which is sharper than the box filter with less aliasing
+}; // enum class ImageMipFilter
+
+
+// Options for generating mipmap chains
+struct ImageMipOptions final
+{
+public:
+	ImageMipFilter filter;
+	VegaBool srgb;			// If the color channels are sRGB encoded, which are then filtered as linear values
+	float alphaCutoff;		// If in (0, 1), alpha is scaled in each level to keep the alpha test coverage of the image
+}; // struct ImageMipOptions
+
+
+// A generated mipmap chain, with all levels in one allocation
+// Level sizes are the image size shifted right by the level index, with a minimum of one.
+struct ImageMipChain final
+{
+public:
+	static constexpr uint32_t MAX_LEVELS{ 32 };
+
+	const uint8_t* data;			// The chain, starting with the full size image
+	size_t size;					// The total size of all levels
+	uint32_t levelCount;
+	size_t offsets[MAX_LEVELS];		// The offset of each level in the chain
+}; // struct ImageMipChain
+
+
+// Generates mipmap chains from 8-bit image data
+// Each level is filtered from the level above it, with the filter split into horizontal and vertical passes on float
+// values, or with a direct 2x2 average for box filtered levels with even sizes. Levels are split into bands of rows
+// that are filtered on the shared thread pool.
+class MipGenerator final
+{
+public:
+	// The number of levels in the full chain for the image size
+	static uint32_t LevelCount(uint32_t width, uint32_t height);
+	// Sets the offset of each level in the full chain, and returns the total size of the chain
+	static size_t Layout(uint32_t width, uint32_t height, uint32_t channels, size_t* offsets);
+	// Generates the full chain into dst, which must have the size given by Layout, the first level is copied from src
+	static void Generate(const uint8_t* src, uint32_t width, uint32_t height, uint32_t channels,
+		const ImageMipOptions& options, uint8_t* dst);
+}; // class MipGenerator
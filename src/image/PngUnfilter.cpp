@@ -0,0 +1,243 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#include "./PngUnfilter.hpp"
+
+#include "../util/CpuFeatures.hpp"
+
+#include <cstring>
+
+#include <immintrin.h>
+
+
+// The PNG filter types
+static constexpr uint32_t FILTER_SUB{ 1 };
+static constexpr uint32_t FILTER_UP{ 2 };
+static constexpr uint32_t FILTER_AVG{ 3 };
+static constexpr uint32_t FILTER_PAETH{ 4 };
+
+
+// ====================================================================================================================
+// Loads one pixel into the low bytes, with the other bytes zero
+template<uint32_t Bpp>
+static inline __m128i LoadPixel(const uint8_t* src)
+{
+	int32_t bits = 0;
+	std::memcpy(&bits, src, Bpp);
+	return _mm_cvtsi32_si128(bits);
+}
+
+// ====================================================================================================================
+// Stores the pixel in the low bytes
+template<uint32_t Bpp>
+static inline void StorePixel(uint8_t* dst, __m128i pixel)
+{
+	const int32_t bits = _mm_cvtsi128_si32(pixel);
+	std::memcpy(dst, &bits, Bpp);
+}
+
+// ====================================================================================================================
+// Repeats the pixel in the low bytes over the first 4 pixels of the register
+template<uint32_t Bpp>
+static inline __m128i SpreadPixel(__m128i pixel)
+{
+	pixel = _mm_add_epi8(pixel, _mm_slli_si128(pixel, Bpp));
+	return _mm_add_epi8(pixel, _mm_slli_si128(pixel, 2 * Bpp));
+}
+
+// ====================================================================================================================
+static void UpSse2(uint8_t* cur, const uint8_t* prior, const uint8_t* raw, uint32_t count)
+{
+	uint32_t i = 0;
+	for (; (i + 16) <= count; i += 16) {
+		const auto r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(raw + i));
+		const auto p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(prior + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(cur + i), _mm_add_epi8(r, p));
+	}
+	for (; i < count; ++i) {
+		cur[i] = uint8_t(raw[i] + prior[i]);
+	}
+}
+
+// ====================================================================================================================
+// Sub is a running sum of the pixels, so 4 pixels are summed in the register with two shifted adds, then offset by
+// the last pixel of the previous group. The stores overlap the next group for 3 byte pixels.
+template<uint32_t Bpp>
+static void SubSse2(uint8_t* cur, const uint8_t* raw, uint32_t count)
+{
+	const auto pixelMask = _mm_cvtsi32_si128(int32_t(0xFFFFFFFFu >> (32 - (8 * Bpp))));
+	auto carry = SpreadPixel<Bpp>(LoadPixel<Bpp>(cur - Bpp));
+	uint32_t i = 0;
+	for (; (i + 16) <= count; i += 4 * Bpp) {
+		auto x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(raw + i));
+		x = _mm_add_epi8(x, _mm_slli_si128(x, Bpp));
+		x = _mm_add_epi8(x, _mm_slli_si128(x, 2 * Bpp));
+		x = _mm_add_epi8(x, carry);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(cur + i), x);
+		carry = SpreadPixel<Bpp>(_mm_and_si128(_mm_srli_si128(x, 3 * Bpp), pixelMask));
+	}
+	for (; i < count; ++i) {
+		cur[i] = uint8_t(raw[i] + *(cur + i - Bpp));
+	}
+}
+
+// ====================================================================================================================
+// Avg for one pixel, floor((a + b) / 2) is computed from the rounding up average
+static inline __m128i AvgStep(__m128i a, __m128i b, __m128i raw)
+{
+	const auto avg = _mm_sub_epi8(_mm_avg_epu8(a, b), _mm_and_si128(_mm_xor_si128(a, b), _mm_set1_epi8(1)));
+	return _mm_add_epi8(raw, avg);
+}
+
+// ====================================================================================================================
+// Paeth for one pixel, as 16-bit values, with the same tie breaking as stbi__paeth (a, then b, then c)
+static inline __m128i PaethStep(__m128i a, __m128i b, __m128i c, __m128i raw)
+{
+	// With p = a + b - c: |p - a| = |b - c|, |p - b| = |a - c|, and |p - c| = |(b - c) + (a - c)|
+	const auto zero = _mm_setzero_si128();
+	auto pa = _mm_sub_epi16(b, c);
+	auto pb = _mm_sub_epi16(a, c);
+	auto pc = _mm_add_epi16(pa, pb);
+	pa = _mm_max_epi16(pa, _mm_sub_epi16(zero, pa));
+	pb = _mm_max_epi16(pb, _mm_sub_epi16(zero, pb));
+	pc = _mm_max_epi16(pc, _mm_sub_epi16(zero, pc));
+	const auto smallest = _mm_min_epi16(pc, _mm_min_epi16(pa, pb));
+	const auto useA = _mm_cmpeq_epi16(smallest, pa);
+	const auto useB = _mm_cmpeq_epi16(smallest, pb);
+	const auto bc = _mm_or_si128(_mm_and_si128(useB, b), _mm_andnot_si128(useB, c));
+	const auto pred = _mm_or_si128(_mm_and_si128(useA, a), _mm_andnot_si128(useA, bc));
+
+	// The byte add wraps the low bytes and leaves the high bytes zero
+	return _mm_add_epi8(raw, pred);
+}
+
+// ====================================================================================================================
+// Avg and Paeth depend on the previous output pixel, so the pixels are computed one at a time. Groups of 4 pixels
+// share one load, and each pixel is stored as 4 bytes, with the extra byte of 3 byte pixels overwritten by the next.
+template<uint32_t Bpp>
+static void AvgSse2(uint8_t* cur, const uint8_t* prior, const uint8_t* raw, uint32_t count)
+{
+	auto a = LoadPixel<Bpp>(cur - Bpp);
+	uint32_t i = 0;
+	for (; (i + 16) <= count; i += 4 * Bpp) {
+		const auto r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(raw + i));
+		const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(prior + i));
+		a = AvgStep(a, b, r);
+		StorePixel<4>(cur + i, a);
+		a = AvgStep(a, _mm_srli_si128(b, Bpp), _mm_srli_si128(r, Bpp));
+		StorePixel<4>(cur + i + Bpp, a);
+		a = AvgStep(a, _mm_srli_si128(b, 2 * Bpp), _mm_srli_si128(r, 2 * Bpp));
+		StorePixel<4>(cur + i + (2 * Bpp), a);
+		a = AvgStep(a, _mm_srli_si128(b, 3 * Bpp), _mm_srli_si128(r, 3 * Bpp));
+		StorePixel<4>(cur + i + (3 * Bpp), a);
+	}
+	for (; i < count; i += Bpp) {
+		a = AvgStep(a, LoadPixel<Bpp>(prior + i), LoadPixel<Bpp>(raw + i));
+		StorePixel<Bpp>(cur + i, a);
+	}
+}
+
+// ====================================================================================================================
+template<uint32_t Bpp>
+static void PaethSse2(uint8_t* cur, const uint8_t* prior, const uint8_t* raw, uint32_t count)
+{
+	const auto zero = _mm_setzero_si128();
+	auto a = _mm_unpacklo_epi8(LoadPixel<Bpp>(cur - Bpp), zero);
+	auto c = _mm_unpacklo_epi8(LoadPixel<Bpp>(prior - Bpp), zero);
+	uint32_t i = 0;
+	for (; (i + 16) <= count; i += 4 * Bpp) {
+		const auto r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(raw + i));
+		const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(prior + i));
+		const auto b0 = _mm_unpacklo_epi8(b, zero);
+		a = PaethStep(a, b0, c, _mm_unpacklo_epi8(r, zero));
+		StorePixel<4>(cur + i, _mm_packus_epi16(a, a));
+		const auto b1 = _mm_unpacklo_epi8(_mm_srli_si128(b, Bpp), zero);
+		a = PaethStep(a, b1, b0, _mm_unpacklo_epi8(_mm_srli_si128(r, Bpp), zero));
+		StorePixel<4>(cur + i + Bpp, _mm_packus_epi16(a, a));
+		const auto b2 = _mm_unpacklo_epi8(_mm_srli_si128(b, 2 * Bpp), zero);
+		a = PaethStep(a, b2, b1, _mm_unpacklo_epi8(_mm_srli_si128(r, 2 * Bpp), zero));
+		StorePixel<4>(cur + i + (2 * Bpp), _mm_packus_epi16(a, a));
+		const auto b3 = _mm_unpacklo_epi8(_mm_srli_si128(b, 3 * Bpp), zero);
+		a = PaethStep(a, b3, b2, _mm_unpacklo_epi8(_mm_srli_si128(r, 3 * Bpp), zero));
+		StorePixel<4>(cur + i + (3 * Bpp), _mm_packus_epi16(a, a));
+		c = b3;
+	}
+	for (; i < count; i += Bpp) {
+		const auto b = _mm_unpacklo_epi8(LoadPixel<Bpp>(prior + i), zero);
+		a = PaethStep(a, b, c, _mm_unpacklo_epi8(LoadPixel<Bpp>(raw + i), zero));
+		StorePixel<Bpp>(cur + i, _mm_packus_epi16(a, a));
+		c = b;
+	}
+}
+
+// ====================================================================================================================
+VEGA_TARGET_AVX2 static void UpAvx2(uint8_t* cur, const uint8_t* prior, const uint8_t* raw, uint32_t count)
+{
+	uint32_t i = 0;
+	for (; (i + 32) <= count; i += 32) {
+		const auto r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(raw + i));
+		const auto p = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(prior + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(cur + i), _mm256_add_epi8(r, p));
+	}
+	UpSse2(cur + i, prior + i, raw + i, count - i);
+}
+
+// ====================================================================================================================
+// As SubSse2, with 4 pixels in each lane and the sum of the low lane carried into the high lane
+template<uint32_t Bpp>
+VEGA_TARGET_AVX2 static void SubAvx2(uint8_t* cur, const uint8_t* raw, uint32_t count)
+{
+	// Shuffle to repeat the last pixel of a lane (bytes 9-11, or 12-15) over the first 4 pixels of the lane
+	const auto spreadLast = (Bpp == 3)
+		? _mm256_setr_epi8(9, 10, 11, 9, 10, 11, 9, 10, 11, 9, 10, 11, -1, -1, -1, -1,
+			9, 10, 11, 9, 10, 11, 9, 10, 11, 9, 10, 11, -1, -1, -1, -1)
+		: _mm256_setr_epi8(12, 13, 14, 15, 12, 13, 14, 15, 12, 13, 14, 15, 12, 13, 14, 15,
+			12, 13, 14, 15, 12, 13, 14, 15, 12, 13, 14, 15, 12, 13, 14, 15);
+	auto carry = _mm256_broadcastsi128_si256(SpreadPixel<Bpp>(LoadPixel<Bpp>(cur - Bpp)));
+	uint32_t i = 0;
+	for (; (i + 16 + (4 * Bpp)) <= count; i += 8 * Bpp) {
+		const auto lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(raw + i));
+		const auto hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(raw + i + (4 * Bpp)));
+		auto x = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+		x = _mm256_add_epi8(x, _mm256_slli_si256(x, Bpp));
+		x = _mm256_add_epi8(x, _mm256_slli_si256(x, 2 * Bpp));
+		x = _mm256_add_epi8(x, _mm256_shuffle_epi8(_mm256_permute2x128_si256(x, x, 0x08), spreadLast));
+		x = _mm256_add_epi8(x, carry);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(cur + i), _mm256_castsi256_si128(x));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(cur + i + (4 * Bpp)), _mm256_extracti128_si256(x, 1));
+		carry = _mm256_shuffle_epi8(_mm256_permute2x128_si256(x, x, 0x11), spreadLast);
+	}
+	SubSse2<Bpp>(cur + i, raw + i, count - i);
+}
+
+// ====================================================================================================================
+template<uint32_t Bpp>
+static void UnfilterPixels(uint8_t* cur, const uint8_t* prior, const uint8_t* raw, uint32_t count, uint32_t filter)
+{
+	const bool avx2 = CpuFeatures::HasAvx2();
+	switch (filter) {
+		case FILTER_SUB: avx2 ? SubAvx2<Bpp>(cur, raw, count) : SubSse2<Bpp>(cur, raw, count); break;
+		case FILTER_UP: avx2 ? UpAvx2(cur, prior, raw, count) : UpSse2(cur, prior, raw, count); break;
+		case FILTER_AVG: AvgSse2<Bpp>(cur, prior, raw, count); break;
+		case FILTER_PAETH: PaethSse2<Bpp>(cur, prior, raw, count); break;
+	}
+}
+
+// ====================================================================================================================
+bool PngUnfilter::Unfilter(uint8_t* cur, const uint8_t* prior, const uint8_t* raw, uint32_t count, uint32_t filter,
+	uint32_t bpp)
+{
+	if (((bpp != 3) && (bpp != 4)) || (filter < FILTER_SUB) || (filter > FILTER_PAETH) || ((count % bpp) != 0)) {
+		return false;
+	}
+	if (bpp == 3) {
+		UnfilterPixels<3>(cur, prior, raw, count, filter);
+	}
+	else {
+		UnfilterPixels<4>(cur, prior, raw, count, filter);
+	}
+	return true;
+}
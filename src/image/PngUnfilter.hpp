@@ -0,0 +1,24 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include "../config.hpp"
+
+
+// Vectorized PNG scanline unfiltering for 8-bit images with 3 or 4 bytes per pixel
+// Up is computed 16 bytes at a time (32 with AVX2), and Sub as a prefix sum over the pixels in each register. Avg and
+// Paeth depend on the previous output pixel, so those are computed one pixel at a time with the channels in parallel.
+// The results match the stb_image loops exactly.
+class PngUnfilter final
+{
+public:
+	// Unfilters the scanline bytes after the first pixel, which must already be unfiltered: cur and raw point to the
+	// second pixel, and prior to the second pixel of the previous scanline. The filter is the PNG filter type.
+	// Returns false, without writing anything, for filters or pixel sizes that are not supported.
+	static bool Unfilter(uint8_t* cur, const uint8_t* prior, const uint8_t* raw, uint32_t count, uint32_t filter,
+		uint32_t bpp);
+}; // class PngUnfilter
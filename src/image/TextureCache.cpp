@@ -0,0 +1,175 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#include "./TextureCache.hpp"
+#include "../util/Hash.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#if defined(VEGA_WIN32)
+#	include <Windows.h>
+#else
+#	include <unistd.h>
+#endif
+
+
+// The header of a cache entry file
+struct TextureCacheHeader final
+{
+public:
+	char magic[4];
+	uint32_t version;
+	TextureCache::Key key;
+	uint32_t levelCount;
+	uint32_t reserved;
+	uint64_t dataOffset;
+	uint64_t dataSize;
+	uint64_t offsets[ImageMipChain::MAX_LEVELS];
+}; // struct TextureCacheHeader
+
+static constexpr char TEXTURE_CACHE_MAGIC[4]{ 'V', 'T', 'X', 'C' };
+static constexpr uint32_t TEXTURE_CACHE_VERSION{ 1 };
+static constexpr uint64_t TEXTURE_CACHE_ALIGN{ 64 };
+
+
+// ====================================================================================================================
+TextureCache::Key TextureCache::MakeKey(const uint8_t* content, size_t size, uint32_t width, uint32_t height,
+	const ImageCompressOptions& options)
+{
+	Key key{ };
+	key.contentHash = Hash::XXH64(content, size);
+	key.contentSize = size;
+	key.width = width;
+	key.height = height;
+	key.format = uint32_t(options.format);
+	key.quality = (options.format == TextureFormat::BC7) ?
+		std::min(options.quality, uint32_t(ImageCompressOptions::MAX_QUALITY)) : 0;
+	if (options.mipmaps) {
+		const auto& mip = options.mipOptions;
+		key.mipmaps = 1;
+		key.mipFilter = uint32_t(mip.filter);
+		key.mipSrgb = mip.srgb ? 1 : 0;
+		if ((mip.alphaCutoff > 0) && (mip.alphaCutoff < 1)) {
+			std::memcpy(&key.mipAlphaCutoff, &mip.alphaCutoff, sizeof(float));
+		}
+	}
+	return key;
+}
+
+// ====================================================================================================================
+std::string TextureCache::EntryPath(const std::string& dir, const Key& key)
+{
+	char name[24];
+	const uint64_t hash = Hash::XXH64(reinterpret_cast<const uint8_t*>(&key), sizeof(key));
+	snprintf(name, sizeof(name), "%016llx.vtc", static_cast<unsigned long long>(hash));
+	if (dir.empty()) {
+		return name;
+	}
+	const char last = dir.back();
+	return ((last == '/') || (last == '\\')) ? (dir + name) : (dir + '/' + name);
+}
+
+// ====================================================================================================================
+bool TextureCache::Save(const std::string& path, const Key& key, const ImageMipChain& chain)
+{
+	TextureCacheHeader header{ };
+	std::memcpy(header.magic, TEXTURE_CACHE_MAGIC, sizeof(TEXTURE_CACHE_MAGIC));
+	header.version = TEXTURE_CACHE_VERSION;
+	header.key = key;
+	header.levelCount = chain.levelCount;
+	header.dataOffset = (sizeof(header) + TEXTURE_CACHE_ALIGN - 1) & ~(TEXTURE_CACHE_ALIGN - 1);
+	header.dataSize = chain.size;
+	for (uint32_t li = 0; li < chain.levelCount; ++li) {
+		header.offsets[li] = chain.offsets[li];
+	}
+
+	// Write to a temporary file first, so the entry path only ever has complete entries
+	// Each writer (in any process or thread) uses its own temporary file
+	static std::atomic<uint32_t> TmpCounter{ 0 };
+#if defined(VEGA_WIN32)
+	const auto pid = uint64_t(GetCurrentProcessId());
+#else
+	const auto pid = uint64_t(getpid());
+#endif
+	const std::string tmpPath = path + '.' + std::to_string(pid) + '.' + std::to_string(TmpCounter++) + ".tmp";
+	{
+		std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) {
+			return false;
+		}
+		const char padding[TEXTURE_CACHE_ALIGN]{ };
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(padding, std::streamsize(header.dataOffset - sizeof(header)));
+		file.write(reinterpret_cast<const char*>(chain.data), std::streamsize(chain.size));
+		if (!file.good()) {
+			file.close();
+			std::remove(tmpPath.c_str());
+			return false;
+		}
+	}
+	// Replace any existing entry in one step
+#if defined(VEGA_WIN32)
+	const bool moved = MoveFileExA(tmpPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+	const bool moved = std::rename(tmpPath.c_str(), path.c_str()) == 0;
+#endif
+	if (!moved) {
+		std::remove(tmpPath.c_str());
+		return false;
+	}
+	return true;
+}
+
+// ====================================================================================================================
+bool TextureCache::Load(const std::string& path, const Key& key, std::unique_ptr<MappedFile>* file,
+	ImageMipChain* chain)
+{
+	std::unique_ptr<MappedFile> mapped{ new MappedFile(path) };
+	if (!mapped->isOpen() || (mapped->size() < sizeof(TextureCacheHeader))) {
+		return false;
+	}
+
+	// Validate the header against the key and the file size
+	TextureCacheHeader header;
+	std::memcpy(&header, mapped->data(), sizeof(header));
+	if ((std::memcmp(header.magic, TEXTURE_CACHE_MAGIC, sizeof(TEXTURE_CACHE_MAGIC)) != 0) ||
+			(header.version != TEXTURE_CACHE_VERSION) || (std::memcmp(&header.key, &key, sizeof(Key)) != 0) ||
+			(header.dataOffset < sizeof(header)) || (header.dataOffset > mapped->size()) ||
+			(header.dataSize != (mapped->size() - header.dataOffset))) {
+		return false;
+	}
+
+	// The level layout must match the layout of the texture data for the key
+	const uint32_t levelCount = key.mipmaps ? MipGenerator::LevelCount(key.width, key.height) : 1;
+	if (header.levelCount != levelCount) {
+		return false;
+	}
+	uint64_t size = 0;
+	for (uint32_t li = 0; li < levelCount; ++li) {
+		if (header.offsets[li] != size) {
+			return false;
+		}
+		size += BlockCompress::LevelSize(TextureFormat(key.format), std::max(key.width >> li, 1u),
+			std::max(key.height >> li, 1u));
+	}
+	if (size != header.dataSize) {
+		return false;
+	}
+
+	// Point the chain into the mapping
+	chain->data = mapped->data() + header.dataOffset;
+	chain->size = size_t(header.dataSize);
+	chain->levelCount = header.levelCount;
+	for (uint32_t li = 0; li < ImageMipChain::MAX_LEVELS; ++li) {
+		chain->offsets[li] = size_t(header.offsets[li]);
+	}
+	*file = std::move(mapped);
+	return true;
+}
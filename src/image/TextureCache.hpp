@@ -0,0 +1,49 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include "../config.hpp"
+#include "./BlockCompress.hpp"
+#include "../util/MappedFile.hpp"
+
+#include <memory>
+
+
+// Persists compressed texture data in a cache directory, with one file per entry
+// Entries are named by a hash of their key, and contain a fixed size header followed by the texture data, which starts
+// on a 64-byte boundary so that the data can be used directly from a mapping of the entry file. Each writer uses its
+// own temporary file, which then replaces the entry in one step, so concurrent writers never see partial entries.
+class TextureCache final
+{
+public:
+	// Identifies a cache entry, using the hash of the encoded image file and all options that change the texture data
+	struct Key final
+	{
+	public:
+		uint64_t contentHash;
+		uint64_t contentSize;
+		uint32_t width;
+		uint32_t height;
+		uint32_t format;
+		uint32_t quality;
+		uint32_t mipmaps;
+		uint32_t mipFilter;
+		uint32_t mipSrgb;
+		uint32_t mipAlphaCutoff;	// The bits of the float cutoff
+	}; // struct Key
+
+	// Creates the key for the encoded image file, options that do not change the texture data are ignored
+	static Key MakeKey(const uint8_t* content, size_t size, uint32_t width, uint32_t height,
+		const ImageCompressOptions& options);
+	// The path of the entry for the key in the cache directory
+	static std::string EntryPath(const std::string& dir, const Key& key);
+	// Writes the texture data as the entry for the key
+	static bool Save(const std::string& path, const Key& key, const ImageMipChain& chain);
+	// Maps the entry for the key, and points the chain at the mapped texture data, false if missing or not matching
+	static bool Load(const std::string& path, const Key& key, std::unique_ptr<MappedFile>* file,
+		ImageMipChain* chain);
+}; // class TextureCache
@@ -0,0 +1,240 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#include "./TextureContainer.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+
+// DDS header sizes and flags
+static constexpr size_t DDS_HEADER_SIZE{ 128 };			// Including the magic
+static constexpr size_t DDS_DX10_HEADER_SIZE{ 20 };
+static constexpr uint32_t DDSD_MIPMAPCOUNT{ 0x20000 };
+static constexpr uint32_t DDPF_FOURCC{ 0x4 };
+static constexpr uint32_t DDPF_RGB{ 0x40 };
+static constexpr uint32_t DDSCAPS2_CUBEMAP{ 0x200 };
+static constexpr uint32_t DDSCAPS2_VOLUME{ 0x200000 };
+static constexpr uint32_t DDS_DIMENSION_TEXTURE2D{ 3 };
+static constexpr uint32_t DDS_MISC_TEXTURECUBE{ 0x4 };
+// KTX2 header sizes
+static constexpr uint8_t KTX2_IDENTIFIER[12]{ 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+static constexpr size_t KTX2_HEADER_SIZE{ 80 };			// Including the identifier and the index
+static constexpr size_t KTX2_LEVEL_SIZE{ 24 };
+
+// A supported format of a container, by the format value of the container
+struct FormatMapping final
+{
+public:
+	uint32_t value;
+	TextureFormat format;
+	bool srgb;
+}; // struct FormatMapping
+
+// DXGI_FORMAT values
+static constexpr FormatMapping DXGI_FORMATS[]{
+	{ 28, TextureFormat::RGBA8, false }, { 29, TextureFormat::RGBA8, true },
+	{ 71, TextureFormat::BC1, false }, { 72, TextureFormat::BC1, true },
+	{ 77, TextureFormat::BC3, false }, { 78, TextureFormat::BC3, true },
+	{ 80, TextureFormat::BC4, false },
+	{ 83, TextureFormat::BC5, false },
+	{ 98, TextureFormat::BC7, false }, { 99, TextureFormat::BC7, true }
+};
+// VkFormat values
+static constexpr FormatMapping VK_FORMATS[]{
+	{ 37, TextureFormat::RGBA8, false }, { 43, TextureFormat::RGBA8, true },
+	{ 131, TextureFormat::BC1, false }, { 132, TextureFormat::BC1, true },
+	{ 133, TextureFormat::BC1, false }, { 134, TextureFormat::BC1, true },
+	{ 137, TextureFormat::BC3, false }, { 138, TextureFormat::BC3, true },
+	{ 139, TextureFormat::BC4, false },
+	{ 141, TextureFormat::BC5, false },
+	{ 145, TextureFormat::BC7, false }, { 146, TextureFormat::BC7, true }
+};
+
+
+// ====================================================================================================================
+static inline uint32_t Read32(const uint8_t* data)
+{
+	uint32_t value;
+	std::memcpy(&value, data, 4);
+	return value;
+}
+
+// ====================================================================================================================
+static inline uint64_t Read64(const uint8_t* data)
+{
+	uint64_t value;
+	std::memcpy(&value, data, 8);
+	return value;
+}
+
+// ====================================================================================================================
+static constexpr uint32_t FourCC(char a, char b, char c, char d)
+{
+	return uint32_t(uint8_t(a)) | (uint32_t(uint8_t(b)) << 8) | (uint32_t(uint8_t(c)) << 16) |
+		(uint32_t(uint8_t(d)) << 24);
+}
+
+// ====================================================================================================================
+template<size_t Count>
+static bool FindFormat(const FormatMapping (&mappings)[Count], uint32_t value, ImageTextureInfo* info)
+{
+	for (const auto& mapping : mappings) {
+		if (mapping.value == value) {
+			info->format = mapping.format;
+			info->srgb = mapping.srgb ? VEGA_TRUE : VEGA_FALSE;
+			return true;
+		}
+	}
+	return false;
+}
+
+// ====================================================================================================================
+// Checks that each level (at the file offsets) is inside the file, and points the levels at the file data
+static bool PointLevels(const uint8_t* data, size_t size, uint32_t width, uint32_t height, const uint64_t* offsets,
+	ImageTextureInfo* info, ImageMipChain* levels)
+{
+	if ((width == 0) || (height == 0) || (info->levelCount == 0) ||
+			(info->levelCount > MipGenerator::LevelCount(width, height))) {
+		return false;
+	}
+
+	uint64_t first = UINT64_MAX, end = 0;
+	for (uint32_t li = 0; li < info->levelCount; ++li) {
+		const uint64_t levelSize =
+			BlockCompress::LevelSize(info->format, std::max(width >> li, 1u), std::max(height >> li, 1u));
+		if ((offsets[li] > size) || (levelSize > (size - offsets[li]))) {
+			return false;
+		}
+		first = std::min(first, offsets[li]);
+		end = std::max(end, offsets[li] + levelSize);
+	}
+	levels->data = data + first;
+	levels->size = size_t(end - first);
+	levels->levelCount = info->levelCount;
+	for (uint32_t li = 0; li < ImageMipChain::MAX_LEVELS; ++li) {
+		levels->offsets[li] = (li < info->levelCount) ? size_t(offsets[li] - first) : 0;
+	}
+	return true;
+}
+
+// ====================================================================================================================
+bool TextureContainer::IsDDS(const uint8_t* data, size_t size)
+{
+	return (size >= 4) && (Read32(data) == FourCC('D', 'D', 'S', ' '));
+}
+
+// ====================================================================================================================
+bool TextureContainer::IsKTX2(const uint8_t* data, size_t size)
+{
+	return (size >= sizeof(KTX2_IDENTIFIER)) && (std::memcmp(data, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) == 0);
+}
+
+// ====================================================================================================================
+bool TextureContainer::ParseDDS(const uint8_t* data, size_t size, uint32_t* width, uint32_t* height,
+	ImageTextureInfo* info, ImageMipChain* levels)
+{
+	if (!IsDDS(data, size) || (size < DDS_HEADER_SIZE) || (Read32(data + 4) != (DDS_HEADER_SIZE - 4))) {
+		return false;
+	}
+	const uint32_t flags = Read32(data + 8);
+	*height = Read32(data + 12);
+	*width = Read32(data + 16);
+	const uint32_t mipCount = Read32(data + 28);
+	const uint32_t pfFlags = Read32(data + 80);
+	const uint32_t fourCC = Read32(data + 84);
+	const uint32_t caps2 = Read32(data + 112);
+	if (caps2 & (DDSCAPS2_CUBEMAP | DDSCAPS2_VOLUME)) {
+		return false;
+	}
+
+	// Find the format from the extended header, the four character code, or the pixel masks
+	size_t dataOffset = DDS_HEADER_SIZE;
+	info->srgb = VEGA_FALSE;
+	if ((pfFlags & DDPF_FOURCC) && (fourCC == FourCC('D', 'X', '1', '0'))) {
+		if (size < (DDS_HEADER_SIZE + DDS_DX10_HEADER_SIZE)) {
+			return false;
+		}
+		const uint8_t* const dx10 = data + DDS_HEADER_SIZE;
+		const uint32_t arraySize = Read32(dx10 + 12);
+		if (!FindFormat(DXGI_FORMATS, Read32(dx10), info) || (Read32(dx10 + 4) != DDS_DIMENSION_TEXTURE2D) ||
+				(Read32(dx10 + 8) & DDS_MISC_TEXTURECUBE) || (arraySize > 1)) {
+			return false;
+		}
+		dataOffset += DDS_DX10_HEADER_SIZE;
+	}
+	else if (pfFlags & DDPF_FOURCC) {
+		switch (fourCC) {
+			case FourCC('D', 'X', 'T', '1'): info->format = TextureFormat::BC1; break;
+			case FourCC('D', 'X', 'T', '5'): info->format = TextureFormat::BC3; break;
+			case FourCC('A', 'T', 'I', '1'):
+			case FourCC('B', 'C', '4', 'U'): info->format = TextureFormat::BC4; break;
+			case FourCC('A', 'T', 'I', '2'):
+			case FourCC('B', 'C', '5', 'U'): info->format = TextureFormat::BC5; break;
+			default: return false;
+		}
+	}
+	else if ((pfFlags & DDPF_RGB) && (Read32(data + 88) == 32) && (Read32(data + 92) == 0x000000FF) &&
+			(Read32(data + 96) == 0x0000FF00) && (Read32(data + 100) == 0x00FF0000) &&
+			(Read32(data + 104) == 0xFF000000)) {
+		info->format = TextureFormat::RGBA8;
+	}
+	else {
+		return false;
+	}
+
+	// The levels are stored in order after the headers
+	info->levelCount = ((flags & DDSD_MIPMAPCOUNT) && (mipCount > 0)) ? mipCount : 1;
+	if (info->levelCount > ImageMipChain::MAX_LEVELS) {
+		return false;
+	}
+	uint64_t offsets[ImageMipChain::MAX_LEVELS];
+	uint64_t offset = dataOffset;
+	for (uint32_t li = 0; li < info->levelCount; ++li) {
+		offsets[li] = offset;
+		offset += BlockCompress::LevelSize(info->format, std::max(*width >> li, 1u), std::max(*height >> li, 1u));
+	}
+	return PointLevels(data, size, *width, *height, offsets, info, levels);
+}
+
+// ====================================================================================================================
+bool TextureContainer::ParseKTX2(const uint8_t* data, size_t size, uint32_t* width, uint32_t* height,
+	ImageTextureInfo* info, ImageMipChain* levels)
+{
+	if (!IsKTX2(data, size) || (size < KTX2_HEADER_SIZE)) {
+		return false;
+	}
+	const uint32_t vkFormat = Read32(data + 12);
+	*width = Read32(data + 20);
+	*height = Read32(data + 24);
+	const uint32_t depth = Read32(data + 28);
+	const uint32_t layerCount = Read32(data + 32);
+	const uint32_t faceCount = Read32(data + 36);
+	const uint32_t levelCount = Read32(data + 40);
+	const uint32_t supercompression = Read32(data + 44);
+	if (!FindFormat(VK_FORMATS, vkFormat, info) || (depth != 0) || (layerCount > 1) || (faceCount != 1) ||
+			(supercompression != 0)) {
+		return false;
+	}
+
+	// A level count of zero means that only the base level is stored
+	info->levelCount = std::max(levelCount, 1u);
+	if ((info->levelCount > ImageMipChain::MAX_LEVELS) ||
+			(((size - KTX2_HEADER_SIZE) / KTX2_LEVEL_SIZE) < info->levelCount)) {
+		return false;
+	}
+	uint64_t offsets[ImageMipChain::MAX_LEVELS];
+	for (uint32_t li = 0; li < info->levelCount; ++li) {
+		const uint8_t* const level = data + KTX2_HEADER_SIZE + (li * KTX2_LEVEL_SIZE);
+		const uint64_t levelSize =
+			BlockCompress::LevelSize(info->format, std::max(*width >> li, 1u), std::max(*height >> li, 1u));
+		if (Read64(level + 8) != levelSize) {
+			return false;
+		}
+		offsets[li] = Read64(level);
+	}
+	return PointLevels(data, size, *width, *height, offsets, info, levels);
+}
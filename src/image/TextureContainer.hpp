@@ -0,0 +1,38 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include "../config.hpp"
+#include "./BlockCompress.hpp"
+
+
+// Describes the texture data in a texture container file
+struct ImageTextureInfo final
+{
+public:
+	TextureFormat format;
+	VegaBool srgb;			// If the format is marked as sRGB encoded
+	uint32_t levelCount;	// The number of mip levels stored in the file
+}; // struct ImageTextureInfo
+
+
+// Reads the headers of texture container files (DDS and KTX2), which store already compressed texture data
+// Only single 2D textures are supported (no arrays, cube maps, or volumes), and KTX2 files must not be supercompressed.
+// The levels are not copied, and point directly into the file data.
+class TextureContainer final
+{
+public:
+	// Checks for the DDS or KTX2 file signature
+	static bool IsDDS(const uint8_t* data, size_t size);
+	static bool IsKTX2(const uint8_t* data, size_t size);
+
+	// Parses the header, and points the levels into the file data, false if the file is invalid or unsupported
+	static bool ParseDDS(const uint8_t* data, size_t size, uint32_t* width, uint32_t* height, ImageTextureInfo* info,
+		ImageMipChain* levels);
+	static bool ParseKTX2(const uint8_t* data, size_t size, uint32_t* width, uint32_t* height, ImageTextureInfo* info,
+		ImageMipChain* levels);
+}; // class TextureContainer
@@ -392,6 +392,13 @@ typedef struct
 STBIDEF stbi_uc *stbi_load_from_memory   (stbi_uc           const *buffer, int len   , int *x, int *y, int *channels_in_file, int desired_channels);
 STBIDEF stbi_uc *stbi_load_from_callbacks(stbi_io_callbacks const *clbk  , void *user, int *x, int *y, int *channels_in_file, int desired_channels);
 
+// decode an x by y image with desired_channels (1-4) straight into caller memory, with each row starting out_pitch
+// bytes after the previous row, and nothing written outside of the rows. only JPEG images, and 8-bit PNG images
+// without a palette, transparency, or interlacing that are stored with desired_channels are supported. returns 1 when
+// decoded, 0 on failure, or -1 if the image is not supported, which is known before any image data is decoded, and
+// the image should then be loaded normally.
+STBIDEF int      stbi_load_from_memory_into(stbi_uc const *buffer, int len, int x, int y, int desired_channels, stbi_uc *out, size_t out_pitch);
+
 #ifndef STBI_NO_STDIO
 STBIDEF stbi_uc *stbi_load            (char const *filename, int *x, int *y, int *channels_in_file, int desired_channels);
 STBIDEF stbi_uc *stbi_load_from_file  (FILE *f, int *x, int *y, int *channels_in_file, int desired_channels);
@@ -491,6 +498,47 @@ STBIDEF void stbi_set_flip_vertically_on_load(int flag_true_if_should_flip);
 // calling it will fail to link if your compiler doesn't
 STBIDEF void stbi_set_flip_vertically_on_load_thread(int flag_true_if_should_flip);
 
+// decode parts of JPEG images in parallel: restart intervals are entropy decoded in parallel, the IDCT of baseline
+// scans without restart markers is deferred and run in parallel, and upsampling and color conversion are run in
+// parallel row bands. the function must call func(user, i) for each i in [0, count), and return once all calls are
+// complete. only images loaded from memory use the parallel entropy decoding.
+typedef void (*stbi_parallel_for_func)(int count, void (*func)(void *user, int index), void *user);
+STBIDEF void stbi_set_parallel_for(stbi_parallel_for_func func);
+
+// replace the JPEG decoding kernels, e.g. with versions for a newer instruction set. the kernels must produce exactly
+// the same results as the built-in ones. NULL members keep the built-in kernel, and h_2/hv_2 are the 2x horizontal
+// and 2x2 chroma upsamplers.
+typedef struct
+{
+   void (*idct_block)(stbi_uc *out, int out_stride, short data[64]);
+   void (*YCbCr_to_RGB)(stbi_uc *out, const stbi_uc *y, const stbi_uc *pcb, const stbi_uc *pcr, int count, int step);
+   stbi_uc *(*resample_row_h_2)(stbi_uc *out, stbi_uc *in_near, stbi_uc *in_far, int w, int hs);
+   stbi_uc *(*resample_row_hv_2)(stbi_uc *out, stbi_uc *in_near, stbi_uc *in_far, int w, int hs);
+} stbi_jpeg_kernels;
+STBIDEF void stbi_set_jpeg_kernels(const stbi_jpeg_kernels *kernels);
+
+// replace the PNG scanline unfiltering for 8-bit images, e.g. with a vectorized version. the function is called for
+// the Sub, Up, Avg and Paeth filters (1-4) of each scanline, after the first pixel of the scanline has been
+// unfiltered: cur and raw point to the second pixel, prior points to the second pixel of the previous scanline, and
+// count is the number of bytes left in the scanline. it must return 0 if it doesn't handle the pixel size or filter.
+typedef int (*stbi_png_unfilter_func)(stbi_uc *cur, const stbi_uc *prior, const stbi_uc *raw, int count, int filter, int filter_bytes);
+STBIDEF void stbi_set_png_unfilter(stbi_png_unfilter_func func);
+
+// a span of a zlib stream. PNG image data from memory is decoded in place from the IDAT chunks, so the stream can be
+// split over any number of spans, at any byte.
+typedef struct
+{
+   const stbi_uc *data;
+   int len;
+} stbi_zlib_span;
+
+// replace the zlib decoding of the PNG image data, e.g. with a faster inflate. the stream is given as in_count spans,
+// and out is allocated with exactly the size of the image data given by the PNG header, so decoding can stop once it
+// is full. the function returns the number of bytes written to out, or -1 if the stream is corrupt. parse_header is
+// 0 for the headerless streams in iPhone PNGs.
+typedef int (*stbi_zlib_decode_func)(const stbi_zlib_span *in, int in_count, stbi_uc *out, int out_len, int parse_header);
+STBIDEF void stbi_set_png_zlib_decode(stbi_zlib_decode_func func);
+
 // ZLIB client - used by PNG, available for other purposes
 
 STBIDEF char *stbi_zlib_decode_malloc_guesssize(const char *buffer, int len, int initial_size, int *outlen);
@@ -872,12 +920,14 @@ typedef struct
 #ifndef STBI_NO_JPEG
 static int      stbi__jpeg_test(stbi__context *s);
 static void    *stbi__jpeg_load(stbi__context *s, int *x, int *y, int *comp, int req_comp, stbi__result_info *ri);
+static int      stbi__jpeg_load_into(stbi__context *s, int req_comp, stbi_uc *out, size_t out_pitch);
 static int      stbi__jpeg_info(stbi__context *s, int *x, int *y, int *comp);
 #endif
 
 #ifndef STBI_NO_PNG
 static int      stbi__png_test(stbi__context *s);
 static void    *stbi__png_load(stbi__context *s, int *x, int *y, int *comp, int req_comp, stbi__result_info *ri);
+static int      stbi__png_load_into(stbi__context *s, int req_comp, stbi_uc *out, size_t out_pitch);
 static int      stbi__png_info(stbi__context *s, int *x, int *y, int *comp);
 static int      stbi__png_is16(stbi__context *s);
 #endif
@@ -1064,6 +1114,35 @@ STBIDEF void stbi_set_flip_vertically_on_load(int flag_true_if_should_flip)
    stbi__vertically_flip_on_load_global = flag_true_if_should_flip;
 }
 
+static stbi_parallel_for_func stbi__parallel_for = NULL;
+
+STBIDEF void stbi_set_parallel_for(stbi_parallel_for_func func)
+{
+   stbi__parallel_for = func;
+}
+
+static stbi_jpeg_kernels stbi__jpeg_kernels_override = { NULL, NULL, NULL, NULL };
+
+STBIDEF void stbi_set_jpeg_kernels(const stbi_jpeg_kernels *kernels)
+{
+   stbi_jpeg_kernels none = { NULL, NULL, NULL, NULL };
+   stbi__jpeg_kernels_override = kernels ? *kernels : none;
+}
+
+static stbi_png_unfilter_func stbi__png_unfilter = NULL;
+
+STBIDEF void stbi_set_png_unfilter(stbi_png_unfilter_func func)
+{
+   stbi__png_unfilter = func;
+}
+
+static stbi_zlib_decode_func stbi__png_zlib_decode = NULL;
+
+STBIDEF void stbi_set_png_zlib_decode(stbi_zlib_decode_func func)
+{
+   stbi__png_zlib_decode = func;
+}
+
 #ifndef STBI_THREAD_LOCAL
 #define stbi__vertically_flip_on_load  stbi__vertically_flip_on_load_global
 #else
@@ -1373,6 +1452,26 @@ STBIDEF stbi_uc *stbi_load_from_memory(stbi_uc const *buffer, int len, int *x, i
    return stbi__load_and_postprocess_8bit(&s,x,y,comp,req_comp);
 }
 
+STBIDEF int stbi_load_from_memory_into(stbi_uc const *buffer, int len, int x, int y, int req_comp, stbi_uc *out, size_t out_pitch)
+{
+   stbi__context s;
+   int w, h, comp;
+   if (req_comp < 1 || req_comp > 4 || !out || x <= 0 || out_pitch < (size_t) x * req_comp)
+      return stbi__err("bad req_comp", "Internal error");
+   if (stbi__vertically_flip_on_load) return -1;
+   // the memory is sized for the caller's dimensions, so they must match the header before anything is written
+   if (!stbi_info_from_memory(buffer, len, &w, &h, &comp)) return 0;
+   if (w != x || h != y) return stbi__err("bad size", "Image size does not match");
+   stbi__start_mem(&s,buffer,len);
+   #ifndef STBI_NO_JPEG
+   if (stbi__jpeg_test(&s)) return stbi__jpeg_load_into(&s, req_comp, out, out_pitch);
+   #endif
+   #ifndef STBI_NO_PNG
+   if (stbi__png_test(&s))  return stbi__png_load_into(&s, req_comp, out, out_pitch);
+   #endif
+   return -1;
+}
+
 STBIDEF stbi_uc *stbi_load_from_callbacks(stbi_io_callbacks const *clbk, void *user, int *x, int *y, int *comp, int req_comp)
 {
    stbi__context s;
@@ -1936,7 +2035,12 @@ typedef struct
 // kernels
    void (*idct_block_kernel)(stbi_uc *out, int out_stride, short data[64]);
    void (*YCbCr_to_RGB_kernel)(stbi_uc *out, const stbi_uc *y, const stbi_uc *pcb, const stbi_uc *pcr, int count, int step);
+   stbi_uc *(*resample_row_h_2_kernel)(stbi_uc *out, stbi_uc *in_near, stbi_uc *in_far, int w, int hs);
    stbi_uc *(*resample_row_hv_2_kernel)(stbi_uc *out, stbi_uc *in_near, stbi_uc *in_far, int w, int hs);
+
+// caller memory to convert the rows into, instead of a new image
+   stbi_uc *out_target;
+   size_t out_pitch;
 } stbi__jpeg;
 
 static int stbi__build_huffman(stbi__huffman *h, int *count)
@@ -2872,8 +2976,201 @@ static void stbi__jpeg_reset(stbi__jpeg *j)
    // since we don't even allow 1<<30 pixels
 }
 
+// the number of entropy coded units (blocks for single component scans, otherwise MCUs) in a baseline scan, and the
+// number of blocks in each unit
+static int stbi__jpeg_scan_units(stbi__jpeg *z, int *blocks)
+{
+   int k;
+   if (z->scan_n == 1) {
+      int n = z->order[0];
+      *blocks = 1;
+      return ((z->img_comp[n].x+7) >> 3) * ((z->img_comp[n].y+7) >> 3);
+   }
+   *blocks = 0;
+   for (k=0; k < z->scan_n; ++k)
+      *blocks += z->img_comp[z->order[k]].h * z->img_comp[z->order[k]].v;
+   return z->img_mcu_x * z->img_mcu_y;
+}
+
+// the number of units in each row of units of a baseline scan
+static int stbi__jpeg_scan_row_units(stbi__jpeg *z)
+{
+   return (z->scan_n == 1) ? ((z->img_comp[z->order[0]].x+7) >> 3) : z->img_mcu_x;
+}
+
+// decodes a single unit of a baseline scan, storing the blocks in coeff if given, otherwise running the idct
+static int stbi__jpeg_decode_unit(stbi__jpeg *z, int u, short *coeff)
+{
+   STBI_SIMD_ALIGN(short, data[64]);
+   int k,x,y;
+   int row = stbi__jpeg_scan_row_units(z);
+   int i = u % row, j = u / row;
+   for (k=0; k < z->scan_n; ++k) {
+      int n = z->order[k];
+      int h = (z->scan_n == 1) ? 1 : z->img_comp[n].h;
+      int v = (z->scan_n == 1) ? 1 : z->img_comp[n].v;
+      for (y=0; y < v; ++y) {
+         for (x=0; x < h; ++x) {
+            int ha = z->img_comp[n].ha;
+            short *out = coeff ? coeff : data;
+            if (!stbi__jpeg_decode_block(z, out, z->huff_dc+z->img_comp[n].hd, z->huff_ac+ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) return 0;
+            if (coeff)
+               coeff += 64;
+            else
+               z->idct_block_kernel(z->img_comp[n].data+z->img_comp[n].w2*(j*v+y)*8+(i*h+x)*8, z->img_comp[n].w2, data);
+         }
+      }
+   }
+   return 1;
+}
+
+// runs the idct for the blocks of a unit stored by stbi__jpeg_decode_unit
+static void stbi__jpeg_idct_unit(stbi__jpeg *z, int u, short *coeff)
+{
+   int k,x,y;
+   int row = stbi__jpeg_scan_row_units(z);
+   int i = u % row, j = u / row;
+   for (k=0; k < z->scan_n; ++k) {
+      int n = z->order[k];
+      int h = (z->scan_n == 1) ? 1 : z->img_comp[n].h;
+      int v = (z->scan_n == 1) ? 1 : z->img_comp[n].v;
+      for (y=0; y < v; ++y) {
+         for (x=0; x < h; ++x, coeff += 64)
+            z->idct_block_kernel(z->img_comp[n].data+z->img_comp[n].w2*(j*v+y)*8+(i*h+x)*8, z->img_comp[n].w2, coeff);
+      }
+   }
+}
+
+#define STBI__PARALLEL_GROUPS    64 // the largest number of parallel tasks for a stage
+#define STBI__IDCT_BAND_ROWS     16 // rows of units in each deferred idct band
+
+typedef struct
+{
+   stbi__jpeg *z;
+   stbi_uc **starts; // the start of each restart interval, and the end of the scan
+   int units, intervals, per_group;
+   int *failed;
+   short *coeff;     // deferred idct only
+   int first, row, blocks;
+} stbi__jpeg_parallel_scan;
+
+static void stbi__jpeg_decode_interval_group(void *user, int group)
+{
+   stbi__jpeg_parallel_scan *p = (stbi__jpeg_parallel_scan *) user;
+   int iv, u, end = (group + 1) * p->per_group;
+   stbi__context s;
+   stbi__jpeg *z = (stbi__jpeg *) stbi__malloc(sizeof(stbi__jpeg));
+   if (!z) { p->failed[group] = 1; return; }
+
+   // each interval starts with reset decoder state, so is decoded with a private copy of the decoder
+   memcpy(z, p->z, sizeof(stbi__jpeg));
+   z->s = &s;
+   if (end > p->intervals) end = p->intervals;
+   for (iv = group * p->per_group; iv < end && !p->failed[group]; ++iv) {
+      int u_end = (iv + 1) * z->restart_interval;
+      if (u_end > p->units) u_end = p->units;
+      stbi__start_mem(&s, p->starts[iv], (int) (p->starts[iv+1] - p->starts[iv]));
+      stbi__jpeg_reset(z);
+      for (u = iv * z->restart_interval; u < u_end; ++u) {
+         if (!stbi__jpeg_decode_unit(z, u, NULL)) { p->failed[group] = 1; break; }
+      }
+   }
+   STBI_FREE(z);
+}
+
+static void stbi__jpeg_idct_row(void *user, int index)
+{
+   stbi__jpeg_parallel_scan *p = (stbi__jpeg_parallel_scan *) user;
+   int u = (p->first / p->row + index) * p->row, end = u + p->row;
+   short *coeff = p->coeff + (size_t) (u - p->first) * p->blocks * 64;
+   if (end > p->units) end = p->units;
+   for (; u < end; ++u, coeff += p->blocks * 64)
+      stbi__jpeg_idct_unit(p->z, u, coeff);
+}
+
+// decodes a baseline scan with parallel stages: the restart intervals are decoded in parallel if the scan has restart
+// markers, otherwise the idct is deferred and run in parallel for bands of rows. returns 0 if the scan must be decoded
+// serially, otherwise stores the result of the decode.
+static int stbi__parse_entropy_coded_data_parallel(stbi__jpeg *z, int *result)
+{
+   stbi__jpeg_parallel_scan p;
+   int g, groups, count = 0, marker = STBI__MARKER_none;
+   stbi_uc *c, *end;
+   if (!stbi__parallel_for || z->progressive) return 0;
+
+   p.z = z;
+   p.units = stbi__jpeg_scan_units(z, &p.blocks);
+   p.row = stbi__jpeg_scan_row_units(z);
+   if (!z->restart_interval) {
+      // entropy decode a band of rows, then run the idct for the rows of the band in parallel
+      int band = p.row * STBI__IDCT_BAND_ROWS;
+      stbi__jpeg_reset(z);
+      p.coeff = (short *) stbi__malloc_mad3(band, p.blocks, 64 * sizeof(short), 0);
+      if (!p.coeff) return 0;
+      *result = 1;
+      for (p.first = 0; p.first < p.units && *result; p.first += band) {
+         int u, last = p.first + band;
+         if (last > p.units) last = p.units;
+         for (u = p.first; u < last; ++u) {
+            if (!stbi__jpeg_decode_unit(z, u, p.coeff + (size_t) (u - p.first) * p.blocks * 64)) { *result = 0; break; }
+         }
+         if (*result)
+            stbi__parallel_for((last - p.first + p.row - 1) / p.row, stbi__jpeg_idct_row, &p);
+      }
+      STBI_FREE(p.coeff);
+      return 1;
+   }
+
+   // find the restart markers, and the marker that ends the scan, which must match the intervals of the scan exactly
+   if (z->s->read_from_callbacks) return 0;
+   p.intervals = (p.units + z->restart_interval - 1) / z->restart_interval;
+   if (p.intervals < 2) return 0;
+   p.starts = (stbi_uc **) stbi__malloc_mad2(p.intervals + 1, sizeof(stbi_uc *), 0);
+   if (!p.starts) return 0;
+   p.starts[count++] = z->s->img_buffer;
+   for (c = z->s->img_buffer, end = z->s->img_buffer_end; c < end; ) {
+      int m;
+      if (*c++ != 0xff) continue;
+      while (c < end && *c == 0xff) ++c; // fill bytes
+      if (c == end) break;
+      m = *c++;
+      if (m == 0) continue; // stuffed zero
+      if (!STBI__RESTART(m)) { marker = m; break; }
+      if (count == p.intervals) break;
+      p.starts[count++] = c;
+   }
+   if (count != p.intervals || marker == STBI__MARKER_none) {
+      STBI_FREE(p.starts);
+      return 0;
+   }
+   p.starts[count] = c;
+
+   groups = (p.intervals < STBI__PARALLEL_GROUPS) ? p.intervals : STBI__PARALLEL_GROUPS;
+   p.per_group = (p.intervals + groups - 1) / groups;
+   groups = (p.intervals + p.per_group - 1) / p.per_group;
+   p.failed = (int *) stbi__malloc_mad2(groups, sizeof(int), 0);
+   if (!p.failed) {
+      STBI_FREE(p.starts);
+      return 0;
+   }
+   memset(p.failed, 0, groups * sizeof(int));
+   stbi__parallel_for(groups, stbi__jpeg_decode_interval_group, &p);
+   *result = 1;
+   for (g=0; g < groups; ++g)
+      if (p.failed[g]) *result = 0;
+
+   // continue after the marker that ended the scan, as the serial decoder would
+   z->s->img_buffer = p.starts[p.intervals];
+   z->marker = (unsigned char) marker;
+   STBI_FREE(p.failed);
+   STBI_FREE(p.starts);
+   return 1;
+}
+
 static int stbi__parse_entropy_coded_data(stbi__jpeg *z)
 {
+   int result;
+   if (stbi__parse_entropy_coded_data_parallel(z, &result)) return result;
    stbi__jpeg_reset(z);
    if (!z->progressive) {
       if (z->scan_n == 1) {
@@ -3719,8 +4016,11 @@ static void stbi__YCbCr_to_RGB_simd(stbi_uc *out, stbi_uc const *y, stbi_uc cons
 // set up the kernels
 static void stbi__setup_jpeg(stbi__jpeg *j)
 {
+   j->out_target = NULL;
+   j->out_pitch = 0;
    j->idct_block_kernel = stbi__idct_block;
    j->YCbCr_to_RGB_kernel = stbi__YCbCr_to_RGB_row;
+   j->resample_row_h_2_kernel = stbi__resample_row_h_2;
    j->resample_row_hv_2_kernel = stbi__resample_row_hv_2;
 
 #ifdef STBI_SSE2
@@ -3736,6 +4036,11 @@ static void stbi__setup_jpeg(stbi__jpeg *j)
    j->YCbCr_to_RGB_kernel = stbi__YCbCr_to_RGB_simd;
    j->resample_row_hv_2_kernel = stbi__resample_row_hv_2_simd;
 #endif
+
+   if (stbi__jpeg_kernels_override.idct_block) j->idct_block_kernel = stbi__jpeg_kernels_override.idct_block;
+   if (stbi__jpeg_kernels_override.YCbCr_to_RGB) j->YCbCr_to_RGB_kernel = stbi__jpeg_kernels_override.YCbCr_to_RGB;
+   if (stbi__jpeg_kernels_override.resample_row_h_2) j->resample_row_h_2_kernel = stbi__jpeg_kernels_override.resample_row_h_2;
+   if (stbi__jpeg_kernels_override.resample_row_hv_2) j->resample_row_hv_2_kernel = stbi__jpeg_kernels_override.resample_row_hv_2;
 }
 
 // clean up the temporary component buffers
@@ -3761,6 +4066,171 @@ static stbi_uc stbi__blinn_8x8(stbi_uc x, stbi_uc y)
    return (stbi_uc) ((t + (t >>8)) >> 8);
 }
 
+// resamples and color converts the output rows [j0, j1) into output (which starts at row j0, with pitch bytes between
+// rows), starting from the resampling state for row j0. the 3-channel conversions, and the 1-channel conversions of
+// 4-component images, write one byte past the end of each row. if spill is not NULL, it is a buffer of n*img_x+1 bytes
+// that each row is converted into and then copied out of, otherwise the caller must leave room for that byte after
+// the last row.
+static void stbi__jpeg_convert_rows(stbi__jpeg *z, stbi__resample *res_comp, stbi_uc **linebuf, stbi_uc *output,
+                                    size_t pitch, stbi_uc *spill, int n, int decode_n, int is_rgb, unsigned int j0, unsigned int j1)
+{
+   int k;
+   unsigned int i,j;
+   stbi_uc *coutput[4] = { NULL, NULL, NULL, NULL };
+   for (j=j0; j < j1; ++j) {
+      stbi_uc *row = output + pitch * (j - j0);
+      stbi_uc *out = spill ? spill : row;
+      for (k=0; k < decode_n; ++k) {
+         stbi__resample *r = &res_comp[k];
+         int y_bot = r->ystep >= (r->vs >> 1);
+         coutput[k] = r->resample(linebuf[k],
+                                  y_bot ? r->line1 : r->line0,
+                                  y_bot ? r->line0 : r->line1,
+                                  r->w_lores, r->hs);
+         if (++r->ystep >= r->vs) {
+            r->ystep = 0;
+            r->line0 = r->line1;
+            if (++r->ypos < z->img_comp[k].y)
+               r->line1 += z->img_comp[k].w2;
+         }
+      }
+      if (n >= 3) {
+         stbi_uc *y = coutput[0];
+         if (z->s->img_n == 3) {
+            if (is_rgb) {
+               for (i=0; i < z->s->img_x; ++i) {
+                  out[0] = y[i];
+                  out[1] = coutput[1][i];
+                  out[2] = coutput[2][i];
+                  out[3] = 255;
+                  out += n;
+               }
+            } else {
+               z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
+            }
+         } else if (z->s->img_n == 4) {
+            if (z->app14_color_transform == 0) { // CMYK
+               for (i=0; i < z->s->img_x; ++i) {
+                  stbi_uc m = coutput[3][i];
+                  out[0] = stbi__blinn_8x8(coutput[0][i], m);
+                  out[1] = stbi__blinn_8x8(coutput[1][i], m);
+                  out[2] = stbi__blinn_8x8(coutput[2][i], m);
+                  out[3] = 255;
+                  out += n;
+               }
+            } else if (z->app14_color_transform == 2) { // YCCK
+               z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
+               for (i=0; i < z->s->img_x; ++i) {
+                  stbi_uc m = coutput[3][i];
+                  out[0] = stbi__blinn_8x8(255 - out[0], m);
+                  out[1] = stbi__blinn_8x8(255 - out[1], m);
+                  out[2] = stbi__blinn_8x8(255 - out[2], m);
+                  out += n;
+               }
+            } else { // YCbCr + alpha?  Ignore the fourth channel for now
+               z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
+            }
+         } else
+            for (i=0; i < z->s->img_x; ++i) {
+               out[0] = out[1] = out[2] = y[i];
+               out[3] = 255; // not used if n==3
+               out += n;
+            }
+      } else {
+         if (is_rgb) {
+            if (n == 1)
+               for (i=0; i < z->s->img_x; ++i)
+                  *out++ = stbi__compute_y(coutput[0][i], coutput[1][i], coutput[2][i]);
+            else {
+               for (i=0; i < z->s->img_x; ++i, out += 2) {
+                  out[0] = stbi__compute_y(coutput[0][i], coutput[1][i], coutput[2][i]);
+                  out[1] = 255;
+               }
+            }
+         } else if (z->s->img_n == 4 && z->app14_color_transform == 0) {
+            for (i=0; i < z->s->img_x; ++i) {
+               stbi_uc m = coutput[3][i];
+               stbi_uc r = stbi__blinn_8x8(coutput[0][i], m);
+               stbi_uc g = stbi__blinn_8x8(coutput[1][i], m);
+               stbi_uc b = stbi__blinn_8x8(coutput[2][i], m);
+               out[0] = stbi__compute_y(r, g, b);
+               out[1] = 255;
+               out += n;
+            }
+         } else if (z->s->img_n == 4 && z->app14_color_transform == 2) {
+            for (i=0; i < z->s->img_x; ++i) {
+               out[0] = stbi__blinn_8x8(255 - coutput[0][i], coutput[3][i]);
+               out[1] = 255;
+               out += n;
+            }
+         } else {
+            stbi_uc *y = coutput[0];
+            if (n == 1)
+               for (i=0; i < z->s->img_x; ++i) out[i] = y[i];
+            else
+               for (i=0; i < z->s->img_x; ++i) { *out++ = y[i]; *out++ = 255; }
+         }
+      }
+      if (spill)
+         memcpy(row, spill, (size_t) n * z->s->img_x);
+   }
+}
+
+// moves the resampling state from the first output row to the given row
+static void stbi__resample_seek(stbi__resample *r, stbi__jpeg *z, int k, int row)
+{
+   int steps = r->ystep + row;
+   int wraps = steps / r->vs;
+   int last = z->img_comp[k].y - 1;
+   r->ystep = steps % r->vs;
+   r->ypos = wraps;
+   r->line1 = z->img_comp[k].data + z->img_comp[k].w2 * (wraps < last ? wraps : last);
+   if (wraps)
+      r->line0 = z->img_comp[k].data + z->img_comp[k].w2 * (wraps - 1 < last ? wraps - 1 : last);
+}
+
+#define STBI__CONVERT_BAND_ROWS  32 // the smallest number of rows in each parallel color conversion band
+
+typedef struct
+{
+   stbi__jpeg *z;
+   stbi__resample *res_comp; // the resampling state for the first row
+   stbi_uc *output;
+   size_t pitch;
+   int n, decode_n, is_rgb, rows, spill;
+   int *failed;
+} stbi__jpeg_parallel_convert;
+
+static void stbi__jpeg_convert_band(void *user, int band)
+{
+   stbi__jpeg_parallel_convert *p = (stbi__jpeg_parallel_convert *) user;
+   stbi__resample res[4];
+   stbi_uc *linebuf[4] = { NULL, NULL, NULL, NULL };
+   size_t row_size = (size_t) p->n * p->z->s->img_x;
+   unsigned int j0 = band * p->rows, j1 = j0 + p->rows;
+   stbi_uc *last = (stbi_uc *) stbi__malloc(row_size + 1);
+   int k;
+   if (j1 > p->z->s->img_y) j1 = p->z->s->img_y;
+   if (!last) p->failed[band] = 1;
+   for (k=0; k < p->decode_n; ++k) {
+      res[k] = p->res_comp[k];
+      stbi__resample_seek(&res[k], p->z, k, j0);
+      linebuf[k] = (stbi_uc *) stbi__malloc(p->z->s->img_x + 3);
+      if (!linebuf[k]) p->failed[band] = 1;
+   }
+   if (!p->failed[band] && p->spill) {
+      stbi__jpeg_convert_rows(p->z, res, linebuf, p->output + p->pitch * j0, p->pitch, last, p->n, p->decode_n, p->is_rgb, j0, j1);
+   } else if (!p->failed[band]) {
+      // the last row is converted separately, so that the byte written past the row does not touch the next band
+      stbi__jpeg_convert_rows(p->z, res, linebuf, p->output + p->pitch * j0, p->pitch, NULL, p->n, p->decode_n, p->is_rgb, j0, j1 - 1);
+      stbi__jpeg_convert_rows(p->z, res, linebuf, last, p->pitch, NULL, p->n, p->decode_n, p->is_rgb, j1 - 1, j1);
+      memcpy(p->output + p->pitch * (j1 - 1), last, row_size);
+   }
+   for (k=0; k < p->decode_n; ++k)
+      STBI_FREE(linebuf[k]);
+   STBI_FREE(last);
+}
+
 static stbi_uc *load_jpeg_image(stbi__jpeg *z, int *out_x, int *out_y, int *comp, int req_comp)
 {
    int n, decode_n, is_rgb;
@@ -3785,9 +4255,11 @@ static stbi_uc *load_jpeg_image(stbi__jpeg *z, int *out_x, int *out_y, int *comp
    // resample and color-convert
    {
       int k;
-      unsigned int i,j;
       stbi_uc *output;
-      stbi_uc *coutput[4] = { NULL, NULL, NULL, NULL };
+      // rows converted into caller memory must not write past the row, which the 3 channel conversions, and the 1
+      // channel conversions of 4 component images, can do
+      size_t pitch = z->out_target ? z->out_pitch : (size_t) n * z->s->img_x;
+      int spill = z->out_target && (n == 3 || (n == 1 && z->s->img_n == 4));
 
       stbi__resample res_comp[4];
 
@@ -3808,109 +4280,54 @@ static stbi_uc *load_jpeg_image(stbi__jpeg *z, int *out_x, int *out_y, int *comp
 
          if      (r->hs == 1 && r->vs == 1) r->resample = resample_row_1;
          else if (r->hs == 1 && r->vs == 2) r->resample = stbi__resample_row_v_2;
-         else if (r->hs == 2 && r->vs == 1) r->resample = stbi__resample_row_h_2;
+         else if (r->hs == 2 && r->vs == 1) r->resample = z->resample_row_h_2_kernel;
          else if (r->hs == 2 && r->vs == 2) r->resample = z->resample_row_hv_2_kernel;
          else                               r->resample = stbi__resample_row_generic;
       }
 
       // can't error after this so, this is safe
-      output = (stbi_uc *) stbi__malloc_mad3(n, z->s->img_x, z->s->img_y, 1);
+      output = z->out_target ? z->out_target : (stbi_uc *) stbi__malloc_mad3(n, z->s->img_x, z->s->img_y, 1);
       if (!output) { stbi__cleanup_jpeg(z); return stbi__errpuc("outofmem", "Out of memory"); }
 
-      // now go ahead and resample
-      for (j=0; j < z->s->img_y; ++j) {
-         stbi_uc *out = output + n * z->s->img_x * j;
-         for (k=0; k < decode_n; ++k) {
-            stbi__resample *r = &res_comp[k];
-            int y_bot = r->ystep >= (r->vs >> 1);
-            coutput[k] = r->resample(z->img_comp[k].linebuf,
-                                     y_bot ? r->line1 : r->line0,
-                                     y_bot ? r->line0 : r->line1,
-                                     r->w_lores, r->hs);
-            if (++r->ystep >= r->vs) {
-               r->ystep = 0;
-               r->line0 = r->line1;
-               if (++r->ypos < z->img_comp[k].y)
-                  r->line1 += z->img_comp[k].w2;
-            }
+      // now go ahead and resample, in parallel bands of rows if possible
+      if (stbi__parallel_for && z->s->img_y >= 2 * STBI__CONVERT_BAND_ROWS) {
+         stbi__jpeg_parallel_convert p;
+         int band, bands = z->s->img_y / STBI__CONVERT_BAND_ROWS, failed = 1;
+         if (bands > STBI__PARALLEL_GROUPS) bands = STBI__PARALLEL_GROUPS;
+         p.z = z;
+         p.res_comp = res_comp;
+         p.output = output;
+         p.pitch = pitch;
+         p.spill = spill;
+         p.n = n;
+         p.decode_n = decode_n;
+         p.is_rgb = is_rgb;
+         p.rows = (z->s->img_y + bands - 1) / bands;
+         bands = (z->s->img_y + p.rows - 1) / p.rows;
+         p.failed = (int *) stbi__malloc_mad2(bands, sizeof(int), 0);
+         if (p.failed) {
+            memset(p.failed, 0, bands * sizeof(int));
+            stbi__parallel_for(bands, stbi__jpeg_convert_band, &p);
+            for (band=0, failed=0; band < bands; ++band)
+               failed |= p.failed[band];
+            STBI_FREE(p.failed);
          }
-         if (n >= 3) {
-            stbi_uc *y = coutput[0];
-            if (z->s->img_n == 3) {
-               if (is_rgb) {
-                  for (i=0; i < z->s->img_x; ++i) {
-                     out[0] = y[i];
-                     out[1] = coutput[1][i];
-                     out[2] = coutput[2][i];
-                     out[3] = 255;
-                     out += n;
-                  }
-               } else {
-                  z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
-               }
-            } else if (z->s->img_n == 4) {
-               if (z->app14_color_transform == 0) { // CMYK
-                  for (i=0; i < z->s->img_x; ++i) {
-                     stbi_uc m = coutput[3][i];
-                     out[0] = stbi__blinn_8x8(coutput[0][i], m);
-                     out[1] = stbi__blinn_8x8(coutput[1][i], m);
-                     out[2] = stbi__blinn_8x8(coutput[2][i], m);
-                     out[3] = 255;
-                     out += n;
-                  }
-               } else if (z->app14_color_transform == 2) { // YCCK
-                  z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
-                  for (i=0; i < z->s->img_x; ++i) {
-                     stbi_uc m = coutput[3][i];
-                     out[0] = stbi__blinn_8x8(255 - out[0], m);
-                     out[1] = stbi__blinn_8x8(255 - out[1], m);
-                     out[2] = stbi__blinn_8x8(255 - out[2], m);
-                     out += n;
-                  }
-               } else { // YCbCr + alpha?  Ignore the fourth channel for now
-                  z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
-               }
-            } else
-               for (i=0; i < z->s->img_x; ++i) {
-                  out[0] = out[1] = out[2] = y[i];
-                  out[3] = 255; // not used if n==3
-                  out += n;
-               }
-         } else {
-            if (is_rgb) {
-               if (n == 1)
-                  for (i=0; i < z->s->img_x; ++i)
-                     *out++ = stbi__compute_y(coutput[0][i], coutput[1][i], coutput[2][i]);
-               else {
-                  for (i=0; i < z->s->img_x; ++i, out += 2) {
-                     out[0] = stbi__compute_y(coutput[0][i], coutput[1][i], coutput[2][i]);
-                     out[1] = 255;
-                  }
-               }
-            } else if (z->s->img_n == 4 && z->app14_color_transform == 0) {
-               for (i=0; i < z->s->img_x; ++i) {
-                  stbi_uc m = coutput[3][i];
-                  stbi_uc r = stbi__blinn_8x8(coutput[0][i], m);
-                  stbi_uc g = stbi__blinn_8x8(coutput[1][i], m);
-                  stbi_uc b = stbi__blinn_8x8(coutput[2][i], m);
-                  out[0] = stbi__compute_y(r, g, b);
-                  out[1] = 255;
-                  out += n;
-               }
-            } else if (z->s->img_n == 4 && z->app14_color_transform == 2) {
-               for (i=0; i < z->s->img_x; ++i) {
-                  out[0] = stbi__blinn_8x8(255 - coutput[0][i], coutput[3][i]);
-                  out[1] = 255;
-                  out += n;
-               }
-            } else {
-               stbi_uc *y = coutput[0];
-               if (n == 1)
-                  for (i=0; i < z->s->img_x; ++i) out[i] = y[i];
-               else
-                  for (i=0; i < z->s->img_x; ++i) { *out++ = y[i]; *out++ = 255; }
-            }
+         if (failed) {
+            if (!z->out_target) STBI_FREE(output);
+            stbi__cleanup_jpeg(z);
+            return stbi__errpuc("outofmem", "Out of memory");
+         }
+      } else {
+         stbi_uc *linebuf[4] = { NULL, NULL, NULL, NULL };
+         stbi_uc *spill_row = NULL;
+         for (k=0; k < decode_n; ++k)
+            linebuf[k] = z->img_comp[k].linebuf;
+         if (spill) {
+            spill_row = (stbi_uc *) stbi__malloc_mad2(n, z->s->img_x, 1);
+            if (!spill_row) { stbi__cleanup_jpeg(z); return stbi__errpuc("outofmem", "Out of memory"); }
          }
+         stbi__jpeg_convert_rows(z, res_comp, linebuf, output, pitch, spill_row, n, decode_n, is_rgb, 0, z->s->img_y);
+         STBI_FREE(spill_row);
       }
       stbi__cleanup_jpeg(z);
       *out_x = z->s->img_x;
@@ -3932,6 +4349,21 @@ static void *stbi__jpeg_load(stbi__context *s, int *x, int *y, int *comp, int re
    return result;
 }
 
+static int stbi__jpeg_load_into(stbi__context *s, int req_comp, stbi_uc *out, size_t out_pitch)
+{
+   unsigned char* result;
+   int x, y, comp;
+   stbi__jpeg* j = (stbi__jpeg*) stbi__malloc(sizeof(stbi__jpeg));
+   if (!j) return stbi__err("outofmem", "Out of memory");
+   j->s = s;
+   stbi__setup_jpeg(j);
+   j->out_target = out;
+   j->out_pitch = out_pitch;
+   result = load_jpeg_image(j, &x,&y,&comp,req_comp);
+   STBI_FREE(j);
+   return result ? 1 : 0;
+}
+
 static int stbi__jpeg_test(stbi__context *s)
 {
    int r;
@@ -4060,11 +4492,13 @@ static int stbi__zbuild_huffman(stbi__zhuffman *z, const stbi_uc *sizelist, int
 //    because PNG allows splitting the zlib stream arbitrarily,
 //    and it's annoying structurally to have PNG call ZLIB call PNG,
 //    we require PNG read all the IDATs and combine them into a single
-//    memory buffer
+//    memory buffer, or for memory sources, a list of spans of the
+//    IDAT data in place
 
 typedef struct
 {
    stbi_uc *zbuffer, *zbuffer_end;
+   const stbi_zlib_span *zspan, *zspan_end; // the spans read after zbuffer
    int num_bits;
    stbi__uint32 code_buffer;
 
@@ -4076,9 +4510,21 @@ typedef struct
    stbi__zhuffman z_length, z_distance;
 } stbi__zbuf;
 
+// moves on to the next non-empty span of input, returns 0 if there is none
+static int stbi__znext_span(stbi__zbuf *z)
+{
+   while (z->zspan < z->zspan_end) {
+      z->zbuffer = (stbi_uc *) z->zspan->data;
+      z->zbuffer_end = z->zbuffer + z->zspan->len;
+      ++z->zspan;
+      if (z->zbuffer < z->zbuffer_end) return 1;
+   }
+   return 0;
+}
+
 stbi_inline static int stbi__zeof(stbi__zbuf *z)
 {
-   return (z->zbuffer >= z->zbuffer_end);
+   return (z->zbuffer >= z->zbuffer_end) && !stbi__znext_span(z);
 }
 
 stbi_inline static stbi_uc stbi__zget8(stbi__zbuf *z)
@@ -4091,6 +4537,7 @@ static void stbi__fill_bits(stbi__zbuf *z)
    do {
       if (z->code_buffer >= (1U << z->num_bits)) {
         z->zbuffer = z->zbuffer_end;  /* treat this as EOF so we fail. */
+        z->zspan = z->zspan_end;
         return;
       }
       z->code_buffer |= (unsigned int) stbi__zget8(z) << z->num_bits;
@@ -4294,12 +4741,19 @@ static int stbi__parse_uncompressed_block(stbi__zbuf *a)
    len  = header[1] * 256 + header[0];
    nlen = header[3] * 256 + header[2];
    if (nlen != (len ^ 0xffff)) return stbi__err("zlib corrupt","Corrupt PNG");
-   if (a->zbuffer + len > a->zbuffer_end) return stbi__err("read past buffer","Corrupt PNG");
    if (a->zout + len > a->zout_end)
       if (!stbi__zexpand(a, a->zout, len)) return 0;
-   memcpy(a->zout, a->zbuffer, len);
-   a->zbuffer += len;
-   a->zout += len;
+   // the block can continue over several spans
+   while (len > 0) {
+      int n;
+      if (stbi__zeof(a)) return stbi__err("read past buffer","Corrupt PNG");
+      n = (int) (a->zbuffer_end - a->zbuffer);
+      if (n > len) n = len;
+      memcpy(a->zout, a->zbuffer, n);
+      a->zbuffer += n;
+      a->zout += n;
+      len -= n;
+   }
    return 1;
 }
 
@@ -4391,6 +4845,7 @@ STBIDEF char *stbi_zlib_decode_malloc_guesssize(const char *buffer, int len, int
    if (p == NULL) return NULL;
    a.zbuffer = (stbi_uc *) buffer;
    a.zbuffer_end = (stbi_uc *) buffer + len;
+   a.zspan = a.zspan_end = NULL;
    if (stbi__do_zlib(&a, p, initial_size, 1, 1)) {
       if (outlen) *outlen = (int) (a.zout - a.zout_start);
       return a.zout_start;
@@ -4412,6 +4867,25 @@ STBIDEF char *stbi_zlib_decode_malloc_guesssize_headerflag(const char *buffer, i
    if (p == NULL) return NULL;
    a.zbuffer = (stbi_uc *) buffer;
    a.zbuffer_end = (stbi_uc *) buffer + len;
+   a.zspan = a.zspan_end = NULL;
+   if (stbi__do_zlib(&a, p, initial_size, 1, parse_header)) {
+      if (outlen) *outlen = (int) (a.zout - a.zout_start);
+      return a.zout_start;
+   } else {
+      STBI_FREE(a.zout_start);
+      return NULL;
+   }
+}
+
+// decodes a zlib stream that is split over several spans
+static char *stbi__zlib_decode_spans_malloc(const stbi_zlib_span *spans, int count, int initial_size, int *outlen, int parse_header)
+{
+   stbi__zbuf a;
+   char *p = (char *) stbi__malloc(initial_size);
+   if (p == NULL) return NULL;
+   a.zbuffer = a.zbuffer_end = NULL;
+   a.zspan = spans;
+   a.zspan_end = spans + count;
    if (stbi__do_zlib(&a, p, initial_size, 1, parse_header)) {
       if (outlen) *outlen = (int) (a.zout - a.zout_start);
       return a.zout_start;
@@ -4426,6 +4900,7 @@ STBIDEF int stbi_zlib_decode_buffer(char *obuffer, int olen, char const *ibuffer
    stbi__zbuf a;
    a.zbuffer = (stbi_uc *) ibuffer;
    a.zbuffer_end = (stbi_uc *) ibuffer + ilen;
+   a.zspan = a.zspan_end = NULL;
    if (stbi__do_zlib(&a, obuffer, olen, 0, 1))
       return (int) (a.zout - a.zout_start);
    else
@@ -4439,6 +4914,7 @@ STBIDEF char *stbi_zlib_decode_noheader_malloc(char const *buffer, int len, int
    if (p == NULL) return NULL;
    a.zbuffer = (stbi_uc *) buffer;
    a.zbuffer_end = (stbi_uc *) buffer+len;
+   a.zspan = a.zspan_end = NULL;
    if (stbi__do_zlib(&a, p, 16384, 1, 0)) {
       if (outlen) *outlen = (int) (a.zout - a.zout_start);
       return a.zout_start;
@@ -4453,6 +4929,7 @@ STBIDEF int stbi_zlib_decode_noheader_buffer(char *obuffer, int olen, const char
    stbi__zbuf a;
    a.zbuffer = (stbi_uc *) ibuffer;
    a.zbuffer_end = (stbi_uc *) ibuffer + ilen;
+   a.zspan = a.zspan_end = NULL;
    if (stbi__do_zlib(&a, obuffer, olen, 0, 0))
       return (int) (a.zout - a.zout_start);
    else
@@ -4498,7 +4975,12 @@ typedef struct
 {
    stbi__context *s;
    stbi_uc *idata, *expanded, *out;
+   stbi_zlib_span *spans; // the IDAT data, read in place for memory sources
+   int span_count;
    int depth;
+   stbi_uc *out_target; // caller memory to unfilter the rows into, instead of a new image
+   size_t out_pitch;
+   int target_unsupported;
 } stbi__png;
 
 
@@ -4548,9 +5030,17 @@ static int stbi__create_png_image_raw(stbi__png *a, stbi_uc *raw, stbi__uint32 r
    int output_bytes = out_n*bytes;
    int filter_bytes = img_n*bytes;
    int width = x;
+   size_t pitch;
 
    STBI_ASSERT(out_n == s->img_n || out_n == s->img_n+1);
-   a->out = (stbi_uc *) stbi__malloc_mad3(x, y, output_bytes, 0); // extra bytes to write off the end into
+   if (a->out_target) {
+      // only 8-bit images that are not interlaced are unfiltered into caller memory
+      a->out = a->out_target;
+      pitch = a->out_pitch;
+   } else {
+      a->out = (stbi_uc *) stbi__malloc_mad3(x, y, output_bytes, 0); // extra bytes to write off the end into
+      pitch = stride;
+   }
    if (!a->out) return stbi__err("outofmem", "Out of memory");
 
    if (!stbi__mad3sizes_valid(img_n, x, depth, 7)) return stbi__err("too large", "Corrupt PNG");
@@ -4563,7 +5053,7 @@ static int stbi__create_png_image_raw(stbi__png *a, stbi_uc *raw, stbi__uint32 r
    if (raw_len < img_len) return stbi__err("not enough pixels","Corrupt PNG");
 
    for (j=0; j < y; ++j) {
-      stbi_uc *cur = a->out + stride*j;
+      stbi_uc *cur = a->out + pitch*j;
       stbi_uc *prior;
       int filter = *raw++;
 
@@ -4576,7 +5066,7 @@ static int stbi__create_png_image_raw(stbi__png *a, stbi_uc *raw, stbi__uint32 r
          filter_bytes = 1;
          width = img_width_bytes;
       }
-      prior = cur - stride; // bugfix: need to compute this after 'cur +=' computation above
+      prior = cur - pitch; // bugfix: need to compute this after 'cur +=' computation above
 
       // if first row, use special filter that doesn't sample previous row
       if (j == 0) filter = first_row_filter[filter];
@@ -4620,7 +5110,11 @@ static int stbi__create_png_image_raw(stbi__png *a, stbi_uc *raw, stbi__uint32 r
          #define STBI__CASE(f) \
              case f:     \
                 for (k=0; k < nk; ++k)
-         switch (filter) {
+         // the first-row filters (which don't sample the previous row) always use the loops below
+         if (depth == 8 && filter >= STBI__F_sub && filter <= STBI__F_paeth && stbi__png_unfilter &&
+             stbi__png_unfilter(cur, prior, raw, nk, filter, filter_bytes)) {
+            // unfiltered by the replacement function
+         } else switch (filter) {
             // "none" filter turns into a memcpy here; make that explicit.
             case STBI__F_none:         memcpy(cur, raw, nk); break;
             STBI__CASE(STBI__F_sub)          { cur[k] = STBI__BYTECAST(raw[k] + cur[k-filter_bytes]); } break;
@@ -4792,6 +5286,29 @@ static int stbi__create_png_image(stbi__png *a, stbi_uc *image_data, stbi__uint3
    return 1;
 }
 
+// the exact size of the decoded image data, including the filter byte of each scanline, or 0 if it is too large
+static stbi__uint32 stbi__png_image_data_len(stbi__context *s, int depth, int interlaced)
+{
+   static const int xorig[] = { 0,4,0,2,0,1,0 };
+   static const int yorig[] = { 0,0,4,0,2,0,1 };
+   static const int xspc[]  = { 8,8,4,4,2,2,1 };
+   static const int yspc[]  = { 8,8,8,4,4,2,2 };
+   stbi__uint32 len = 0, x, y;
+   int p;
+   if (!interlaced) {
+      len = ((((s->img_n * s->img_x * depth) + 7) >> 3) + 1) * s->img_y;
+   } else {
+      for (p=0; p < 7; ++p) {
+         x = (s->img_x - xorig[p] + xspc[p]-1) / xspc[p];
+         y = (s->img_y - yorig[p] + yspc[p]-1) / yspc[p];
+         if (x && y)
+            len += ((((s->img_n * x * depth) + 7) >> 3) + 1) * y;
+      }
+   }
+   // the header checks limit the pixel data to 2^31 bytes, so only the filter bytes can push it past INT_MAX
+   return len > 0x7fffffff ? 0 : len;
+}
+
 static int stbi__compute_transparency(stbi__png *z, stbi_uc tc[3], int out_n)
 {
    stbi__context *s = z->s;
@@ -4943,11 +5460,13 @@ static int stbi__parse_png_file(stbi__png *z, int scan, int req_comp)
    stbi_uc has_trans=0, tc[3]={0};
    stbi__uint16 tc16[3];
    stbi__uint32 ioff=0, idata_limit=0, i, pal_len=0;
-   int first=1,k,interlace=0, color=0, is_iphone=0;
+   int first=1,k,interlace=0, color=0, is_iphone=0, span_limit=0;
    stbi__context *s = z->s;
 
    z->expanded = NULL;
    z->idata = NULL;
+   z->spans = NULL;
+   z->span_count = 0;
    z->out = NULL;
 
    if (!stbi__check_png_header(s)) return 0;
@@ -5008,7 +5527,7 @@ static int stbi__parse_png_file(stbi__png *z, int scan, int req_comp)
 
          case STBI__PNG_TYPE('t','R','N','S'): {
             if (first) return stbi__err("first not IHDR", "Corrupt PNG");
-            if (z->idata) return stbi__err("tRNS after IDAT","Corrupt PNG");
+            if (z->idata || z->spans) return stbi__err("tRNS after IDAT","Corrupt PNG");
             if (pal_img_n) {
                if (scan == STBI__SCAN_header) { s->img_n = 4; return 1; }
                if (pal_len == 0) return stbi__err("tRNS before PLTE","Corrupt PNG");
@@ -5034,6 +5553,23 @@ static int stbi__parse_png_file(stbi__png *z, int scan, int req_comp)
             if (pal_img_n && !pal_len) return stbi__err("no PLTE","Corrupt PNG");
             if (scan == STBI__SCAN_header) { s->img_n = pal_img_n; return 1; }
             if ((int)(ioff + c.length) < (int)ioff) return 0;
+            if (!s->io.read) {
+               // memory source, the data is decoded in place so only the span is kept
+               if ((stbi__uint32) (s->img_buffer_end - s->img_buffer) < c.length) return stbi__err("outofdata","Corrupt PNG");
+               if (z->span_count == span_limit) {
+                  stbi_zlib_span *p;
+                  span_limit = span_limit ? span_limit * 2 : 16;
+                  p = (stbi_zlib_span *) STBI_REALLOC_SIZED(z->spans, z->span_count * sizeof(*p), span_limit * sizeof(*p));
+                  if (p == NULL) return stbi__err("outofmem", "Out of memory");
+                  z->spans = p;
+               }
+               z->spans[z->span_count].data = s->img_buffer;
+               z->spans[z->span_count].len = (int) c.length;
+               ++z->span_count;
+               s->img_buffer += c.length;
+               ioff += c.length;
+               break;
+            }
             if (ioff + c.length > idata_limit) {
                stbi__uint32 idata_limit_old = idata_limit;
                stbi_uc *p;
@@ -5051,15 +5587,48 @@ static int stbi__parse_png_file(stbi__png *z, int scan, int req_comp)
 
          case STBI__PNG_TYPE('I','E','N','D'): {
             stbi__uint32 raw_len, bpl;
+            stbi_zlib_span idata_span;
+            const stbi_zlib_span *spans;
+            int span_count;
             if (first) return stbi__err("first not IHDR", "Corrupt PNG");
             if (scan != STBI__SCAN_load) return 1;
-            if (z->idata == NULL) return stbi__err("no IDAT","Corrupt PNG");
-            // initial guess for decoded data size to avoid unnecessary reallocs
-            bpl = (s->img_x * z->depth + 7) / 8; // bytes per line, per component
-            raw_len = bpl * s->img_y * s->img_n /* pixels */ + s->img_y /* filter mode per row */;
-            z->expanded = (stbi_uc *) stbi_zlib_decode_malloc_guesssize_headerflag((char *) z->idata, ioff, raw_len, (int *) &raw_len, !is_iphone);
-            if (z->expanded == NULL) return 0; // zlib should set error
+            if (z->idata == NULL && z->spans == NULL) return stbi__err("no IDAT","Corrupt PNG");
+            if (z->idata) {
+               // the data was copied from a callback source
+               idata_span.data = z->idata;
+               idata_span.len = (int) ioff;
+               spans = &idata_span;
+               span_count = 1;
+            } else {
+               spans = z->spans;
+               span_count = z->span_count;
+            }
+            if (z->out_target) {
+               // see stbi_load_from_memory_into, adding alpha uses the per-pixel unfiltering so it is also excluded
+               if (z->depth != 8 || interlace || pal_img_n || has_trans || is_iphone || req_comp != s->img_n) {
+                  z->target_unsupported = 1;
+                  return 0;
+               }
+            }
+            if (stbi__png_zlib_decode) {
+               // decode into a buffer of exactly the image data size
+               int len;
+               raw_len = stbi__png_image_data_len(s, z->depth, interlace);
+               if (raw_len == 0) return stbi__err("too large", "Corrupt PNG");
+               z->expanded = (stbi_uc *) stbi__malloc(raw_len);
+               if (z->expanded == NULL) return stbi__err("outofmem", "Out of memory");
+               len = stbi__png_zlib_decode(spans, span_count, z->expanded, (int) raw_len, !is_iphone);
+               if (len < 0) return stbi__err("bad zlib", "Corrupt PNG");
+               raw_len = (stbi__uint32) len;
+            } else {
+               // initial guess for decoded data size to avoid unnecessary reallocs
+               bpl = (s->img_x * z->depth + 7) / 8; // bytes per line, per component
+               raw_len = bpl * s->img_y * s->img_n /* pixels */ + s->img_y /* filter mode per row */;
+               z->expanded = (stbi_uc *) stbi__zlib_decode_spans_malloc(spans, span_count, raw_len, (int *) &raw_len, !is_iphone);
+               if (z->expanded == NULL) return 0; // zlib should set error
+            }
             STBI_FREE(z->idata); z->idata = NULL;
+            STBI_FREE(z->spans); z->spans = NULL;
             if ((req_comp == s->img_n+1 && req_comp != 3 && !pal_img_n) || has_trans)
                s->img_out_n = s->img_n+1;
             else
@@ -5141,6 +5710,7 @@ static void *stbi__do_png(stbi__png *p, int *x, int *y, int *n, int req_comp, st
    STBI_FREE(p->out);      p->out      = NULL;
    STBI_FREE(p->expanded); p->expanded = NULL;
    STBI_FREE(p->idata);    p->idata    = NULL;
+   STBI_FREE(p->spans);    p->spans    = NULL;
 
    return result;
 }
@@ -5149,9 +5719,27 @@ static void *stbi__png_load(stbi__context *s, int *x, int *y, int *comp, int req
 {
    stbi__png p;
    p.s = s;
+   p.out_target = NULL;
    return stbi__do_png(&p, x,y,comp,req_comp, ri);
 }
 
+static int stbi__png_load_into(stbi__context *s, int req_comp, stbi_uc *out, size_t out_pitch)
+{
+   stbi__png p;
+   int r;
+   p.s = s;
+   p.out_target = out;
+   p.out_pitch = out_pitch;
+   p.target_unsupported = 0;
+   r = stbi__parse_png_file(&p, STBI__SCAN_load, req_comp);
+   if (p.out == out) p.out = NULL; // owned by the caller
+   STBI_FREE(p.out);      p.out      = NULL;
+   STBI_FREE(p.expanded); p.expanded = NULL;
+   STBI_FREE(p.idata);    p.idata    = NULL;
+   STBI_FREE(p.spans);    p.spans    = NULL;
+   return r ? 1 : p.target_unsupported ? -1 : 0;
+}
+
 static int stbi__png_test(stbi__context *s)
 {
    int r;
@@ -5176,6 +5764,7 @@ static int stbi__png_info(stbi__context *s, int *x, int *y, int *comp)
 {
    stbi__png p;
    p.s = s;
+   p.out_target = NULL;
    return stbi__png_info_raw(&p, x, y, comp);
 }
 
@@ -5183,6 +5772,7 @@ static int stbi__png_is16(stbi__context *s)
 {
    stbi__png p;
    p.s = s;
+   p.out_target = NULL;
    if (!stbi__png_info_raw(&p, NULL, NULL, NULL))
 	   return 0;
    if (p.depth != 16) {
@@ -5395,7 +5985,7 @@ static void *stbi__bmp_load(stbi__context *s, int *x, int *y, int *comp, int req
    }
    if (psize == 0) {
       STBI_ASSERT(info.offset == s->callback_already_read + (int) (s->img_buffer - s->img_buffer_original));
-      if (info.offset != s->callback_already_read + (s->img_buffer - s->buffer_start)) {
+      if (info.offset != s->callback_already_read + (int) (s->img_buffer - s->img_buffer_original)) {
         return stbi__errpuc("bad offset", "Corrupt BMP");
       }
    }
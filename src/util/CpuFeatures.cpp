@@ -0,0 +1,66 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#include "./CpuFeatures.hpp"
+
+#if defined(VEGA_MSVC)
+#	include <intrin.h>
+#else
+#	include <cpuid.h>
+#endif
+
+
+// ====================================================================================================================
+static void Cpuid(uint32_t leaf, uint32_t regs[4])
+{
+#if defined(VEGA_MSVC)
+	int info[4];
+	__cpuidex(info, int(leaf), 0);
+	for (uint32_t i = 0; i < 4; ++i) {
+		regs[i] = uint32_t(info[i]);
+	}
+#else
+	__cpuid_count(leaf, 0, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// ====================================================================================================================
+static uint64_t ReadXcr0()
+{
+#if defined(VEGA_MSVC)
+	return _xgetbv(0);
+#else
+	uint32_t lo, hi;
+	__asm__ volatile ("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+	return (uint64_t(hi) << 32) | lo;
+#endif
+}
+
+// ====================================================================================================================
+static bool DetectAvx2()
+{
+	uint32_t regs[4];
+	Cpuid(0, regs);
+	if (regs[0] < 7) {
+		return false;
+	}
+
+	// The OS must save the YMM registers (OSXSAVE and AVX, with the XMM and YMM state enabled in XCR0)
+	Cpuid(1, regs);
+	const uint32_t osxsaveAvx{ (1u << 27) | (1u << 28) };
+	if (((regs[2] & osxsaveAvx) != osxsaveAvx) || ((ReadXcr0() & 0x6) != 0x6)) {
+		return false;
+	}
+	Cpuid(7, regs);
+	return (regs[1] & (1u << 5)) != 0;
+}
+
+// ====================================================================================================================
+bool CpuFeatures::HasAvx2()
+{
+	static const bool avx2{ DetectAvx2() };
+	return avx2;
+}
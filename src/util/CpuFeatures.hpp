@@ -0,0 +1,26 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include "../config.hpp"
+
+// The library is built for the SSE2 baseline, so functions that use AVX2 are compiled for AVX2 individually, and must
+// only be called if CpuFeatures::HasAvx2() is true
+#if defined(VEGA_MSVC)
+#	define VEGA_TARGET_AVX2
+#else
+#	define VEGA_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+
+// Runtime detection of the instruction set extensions used by the optimized code paths
+class CpuFeatures final
+{
+public:
+	// Checks that the CPU and OS support AVX2, the result is detected once and cached
+	static bool HasAvx2();
+}; // class CpuFeatures
@@ -0,0 +1,89 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#include "./Hash.hpp"
+
+#include <cstring>
+
+
+// XXH64 primes
+static constexpr uint64_t PRIME1{ 11400714785074694791ULL };
+static constexpr uint64_t PRIME2{ 14029467366897019727ULL };
+static constexpr uint64_t PRIME3{ 1609587929392839161ULL };
+static constexpr uint64_t PRIME4{ 9650029242287828579ULL };
+static constexpr uint64_t PRIME5{ 2870177450012600261ULL };
+
+
+// ====================================================================================================================
+static inline uint64_t Rotl(uint64_t value, uint32_t bits)
+{
+	return (value << bits) | (value >> (64 - bits));
+}
+
+// ====================================================================================================================
+static inline uint64_t Read64(const uint8_t* data)
+{
+	uint64_t value;
+	std::memcpy(&value, data, 8);
+	return value;
+}
+
+// ====================================================================================================================
+static inline uint64_t Round(uint64_t acc, uint64_t input)
+{
+	return Rotl(acc + (input * PRIME2), 31) * PRIME1;
+}
+
+// ====================================================================================================================
+static inline uint64_t MergeRound(uint64_t acc, uint64_t value)
+{
+	return ((acc ^ Round(0, value)) * PRIME1) + PRIME4;
+}
+
+// ====================================================================================================================
+uint64_t Hash::XXH64(const uint8_t* data, size_t size)
+{
+	const uint8_t* const end = data + size;
+	uint64_t hash;
+	if (size >= 32) {
+		uint64_t v1 = PRIME1 + PRIME2, v2 = PRIME2, v3 = 0, v4 = 0 - PRIME1;
+		for (; (end - data) >= 32; data += 32) {
+			v1 = Round(v1, Read64(data));
+			v2 = Round(v2, Read64(data + 8));
+			v3 = Round(v3, Read64(data + 16));
+			v4 = Round(v4, Read64(data + 24));
+		}
+		hash = Rotl(v1, 1) + Rotl(v2, 7) + Rotl(v3, 12) + Rotl(v4, 18);
+		hash = MergeRound(hash, v1);
+		hash = MergeRound(hash, v2);
+		hash = MergeRound(hash, v3);
+		hash = MergeRound(hash, v4);
+	}
+	else {
+		hash = PRIME5;
+	}
+	hash += uint64_t(size);
+
+	for (; (end - data) >= 8; data += 8) {
+		hash = (Rotl(hash ^ Round(0, Read64(data)), 27) * PRIME1) + PRIME4;
+	}
+	if ((end - data) >= 4) {
+		uint32_t word;
+		std::memcpy(&word, data, 4);
+		hash = (Rotl(hash ^ (uint64_t(word) * PRIME1), 23) * PRIME2) + PRIME3;
+		data += 4;
+	}
+	for (; data < end; ++data) {
+		hash = Rotl(hash ^ (uint64_t(*data) * PRIME5), 11) * PRIME1;
+	}
+
+	hash ^= hash >> 33;
+	hash *= PRIME2;
+	hash ^= hash >> 29;
+	hash *= PRIME3;
+	hash ^= hash >> 32;
+	return hash;
+}
@@ -0,0 +1,18 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include "../config.hpp"
+
+
+// Hashing of data that is persisted, where the hash values must not change between versions or platforms
+class Hash final
+{
+public:
+	// 64-bit hash of the data (XXH64 with a zero seed)
+	static uint64_t XXH64(const uint8_t* data, size_t size);
+}; // class Hash
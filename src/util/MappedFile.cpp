@@ -0,0 +1,101 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#include "./MappedFile.hpp"
+
+#if defined(VEGA_WIN32)
+#	include <Windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+
+// ====================================================================================================================
+MappedFile::MappedFile(const std::string& path)
+	: path_{ path }
+	, data_{ nullptr }
+	, size_{ 0 }
+#if defined(VEGA_WIN32)
+	, mapping_{ nullptr }
+#endif
+{
+#if defined(VEGA_WIN32)
+	const HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return;
+	}
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || (size.QuadPart == 0)) {
+		CloseHandle(file);
+		return;
+	}
+	const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file); // The mapping keeps the file open
+	if (!mapping) {
+		return;
+	}
+	const auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!view) {
+		CloseHandle(mapping);
+		return;
+	}
+	mapping_ = mapping;
+	data_ = static_cast<const uint8_t*>(view);
+	size_ = uint64_t(size.QuadPart);
+#else
+	const int file = open(path.c_str(), O_RDONLY);
+	if (file < 0) {
+		return;
+	}
+	struct stat info;
+	if ((fstat(file, &info) != 0) || (info.st_size == 0)) {
+		close(file);
+		return;
+	}
+	const auto view = mmap(nullptr, size_t(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+	close(file); // The mapping keeps the file open
+	if (view == MAP_FAILED) {
+		return;
+	}
+	data_ = static_cast<const uint8_t*>(view);
+	size_ = uint64_t(info.st_size);
+#endif
+}
+
+// ====================================================================================================================
+MappedFile::~MappedFile()
+{
+	if (!data_) {
+		return;
+	}
+#if defined(VEGA_WIN32)
+	UnmapViewOfFile(data_);
+	CloseHandle(mapping_);
+#else
+	munmap(const_cast<uint8_t*>(data_), size_t(size_));
+#endif
+	data_ = nullptr;
+}
+
+// ====================================================================================================================
+void MappedFile::prefault() const
+{
+	if (!data_) {
+		return;
+	}
+#if !defined(VEGA_WIN32)
+	madvise(const_cast<uint8_t*>(data_), size_t(size_), MADV_WILLNEED);
+#endif
+	volatile uint8_t sink = 0;
+	for (uint64_t offset = 0; offset < size_; offset += 4096) {
+		sink = sink ^ data_[offset];
+	}
+	(void)sink;
+}
@@ -0,0 +1,39 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include "../config.hpp"
+
+
+// Read-only memory mapping of an entire file
+// Mapped files are not copyable, and are shared between users through std::shared_ptr
+class MappedFile final
+{
+public:
+	explicit MappedFile(const std::string& path);
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator = (const MappedFile&) = delete;
+
+	inline const std::string& path() const { return path_; }
+	inline const uint8_t* data() const { return data_; }
+	inline uint64_t size() const { return size_; }
+	inline bool isOpen() const { return !!data_; }
+
+	// Touches every page of the mapping, so that later reads do not wait on the disk
+	// The pages can still be evicted later under memory pressure
+	void prefault() const;
+
+private:
+	const std::string path_;
+	const uint8_t* data_;
+	uint64_t size_;
+#if defined(VEGA_WIN32)
+	void* mapping_;
+#endif
+}; // class MappedFile
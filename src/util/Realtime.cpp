@@ -0,0 +1,131 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#include "./Realtime.hpp"
+
+#if defined(VEGA_REALTIME_CHECKS)
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+
+// The number of enabled sections the thread is inside of
+static thread_local uint32_t RealtimeDepth{ 0 };
+
+
+// ====================================================================================================================
+RealtimeSection::RealtimeSection(bool enabled)
+	: enabled_{ enabled }
+{
+	if (enabled_) {
+		++RealtimeDepth;
+	}
+}
+
+// ====================================================================================================================
+RealtimeSection::~RealtimeSection()
+{
+	if (enabled_) {
+		--RealtimeDepth;
+	}
+}
+
+// ====================================================================================================================
+void* RealtimeSection::Malloc(size_t size)
+{
+	CheckHeap("malloc");
+	return std::malloc(size);
+}
+
+// ====================================================================================================================
+void* RealtimeSection::Realloc(void* ptr, size_t size)
+{
+	CheckHeap("realloc");
+	return std::realloc(ptr, size);
+}
+
+// ====================================================================================================================
+void RealtimeSection::Free(void* ptr)
+{
+	if (ptr) {
+		CheckHeap("free");
+	}
+	std::free(ptr);
+}
+
+// ====================================================================================================================
+void RealtimeSection::CheckHeap(const char* operation)
+{
+	if (RealtimeDepth != 0) {
+		std::fprintf(stderr, "ContentLoader: heap %s inside of a real-time section\n", operation);
+		std::abort();
+	}
+}
+
+
+// Hook for stb_vorbis, which is compiled as C
+extern "C" void vega_realtime_check_heap(void)
+{
+	RealtimeSection::CheckHeap("malloc");
+}
+
+
+// Replacements for the global allocation functions, only sections inside of the library code can trigger the checks
+// ====================================================================================================================
+void* operator new (size_t size)
+{
+	RealtimeSection::CheckHeap("new");
+	if (const auto ptr = std::malloc(size ? size : 1)) {
+		return ptr;
+	}
+	throw std::bad_alloc{ };
+}
+
+// ====================================================================================================================
+void* operator new[] (size_t size)
+{
+	return operator new (size);
+}
+
+// ====================================================================================================================
+void* operator new (size_t size, const std::nothrow_t&) noexcept
+{
+	RealtimeSection::CheckHeap("new");
+	return std::malloc(size ? size : 1);
+}
+
+// ====================================================================================================================
+void* operator new[] (size_t size, const std::nothrow_t&) noexcept
+{
+	return operator new (size, std::nothrow);
+}
+
+// ====================================================================================================================
+void operator delete (void* ptr) noexcept
+{
+	RealtimeSection::Free(ptr);
+}
+
+// ====================================================================================================================
+void operator delete[] (void* ptr) noexcept
+{
+	RealtimeSection::Free(ptr);
+}
+
+// ====================================================================================================================
+void operator delete (void* ptr, const std::nothrow_t&) noexcept
+{
+	RealtimeSection::Free(ptr);
+}
+
+// ====================================================================================================================
+void operator delete[] (void* ptr, const std::nothrow_t&) noexcept
+{
+	RealtimeSection::Free(ptr);
+}
+
+#endif // defined(VEGA_REALTIME_CHECKS)
@@ -0,0 +1,39 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include "../config.hpp"
+
+
+// Marks a scope on the current thread that must not allocate or free heap memory
+// When the library is built with VEGA_REALTIME_CHECKS, any heap operation made by the library code (including the
+// decoders) inside of an enabled section aborts the process. Otherwise sections compile to nothing.
+class RealtimeSection final
+{
+public:
+#if defined(VEGA_REALTIME_CHECKS)
+	explicit RealtimeSection(bool enabled);
+	~RealtimeSection();
+#else
+	inline explicit RealtimeSection(bool enabled) { (void)enabled; }
+#endif
+
+	RealtimeSection(const RealtimeSection&) = delete;
+	RealtimeSection& operator = (const RealtimeSection&) = delete;
+
+#if defined(VEGA_REALTIME_CHECKS)
+	// Checked heap functions for the decoder allocation macros
+	static void* Malloc(size_t size);
+	static void* Realloc(void* ptr, size_t size);
+	static void Free(void* ptr);
+	// Aborts if the current thread is inside of an enabled section
+	static void CheckHeap(const char* operation);
+
+private:
+	const bool enabled_;
+#endif
+}; // class RealtimeSection
@@ -0,0 +1,120 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#include "./ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+
+// Progress of a parallelFor call, shared with the helper tasks that may start after the call has returned
+struct ParallelForState final
+{
+public:
+	std::atomic<size_t> next;
+	std::atomic<uint32_t> active;	// Helpers that may still claim indices
+	std::mutex mutex;
+	std::condition_variable cond;
+}; // struct ParallelForState
+
+
+// ====================================================================================================================
+ThreadPool::ThreadPool(uint32_t threadCount)
+	: threads_{ }
+	, mutex_{ }
+	, cond_{ }
+	, tasks_{ }
+	, stop_{ false }
+{
+	threads_.reserve(threadCount);
+	for (uint32_t i = 0; i < threadCount; ++i) {
+		threads_.emplace_back([this]() { workerMain(); });
+	}
+}
+
+// ====================================================================================================================
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock{ mutex_ };
+		stop_ = true;
+	}
+	cond_.notify_all();
+	for (auto& thread : threads_) {
+		thread.join();
+	}
+}
+
+// ====================================================================================================================
+void ThreadPool::submit(std::function<void()> task)
+{
+	{
+		std::lock_guard<std::mutex> lock{ mutex_ };
+		tasks_.push_back(std::move(task));
+	}
+	cond_.notify_one();
+}
+
+// ====================================================================================================================
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& func)
+{
+	if (count == 0) {
+		return;
+	}
+
+	// Indices are claimed one at a time, which balances uneven work between the threads
+	// Helpers that start after all indices are claimed exit without touching the function, so the caller only has to
+	// wait for the helpers that are active, and not for helpers that are still queued behind other tasks
+	std::shared_ptr<ParallelForState> state{ new ParallelForState };
+	state->next.store(0);
+	state->active.store(0);
+	const auto run = [count, &func](ParallelForState& state) {
+		for (size_t index; (index = state.next.fetch_add(1)) < count; ) {
+			func(index);
+		}
+	};
+	const uint32_t helpers = uint32_t(std::min<size_t>(threads_.size(), count - 1));
+	for (uint32_t i = 0; i < helpers; ++i) {
+		submit([state, run]() {
+			state->active.fetch_add(1);
+			run(*state);
+			if (state->active.fetch_sub(1) == 1) {
+				std::lock_guard<std::mutex> lock{ state->mutex };
+				state->cond.notify_all();
+			}
+		});
+	}
+
+	run(*state);
+	std::unique_lock<std::mutex> lock{ state->mutex };
+	state->cond.wait(lock, [&state]() { return state->active.load() == 0; });
+}
+
+// ====================================================================================================================
+ThreadPool& ThreadPool::Shared()
+{
+	// Never destroyed, as joining threads while the library is unloaded can deadlock (in DllMain on Windows)
+	static ThreadPool* const pool{ new ThreadPool(std::max(std::thread::hardware_concurrency(), 2u) - 1) };
+	return *pool;
+}
+
+// ====================================================================================================================
+void ThreadPool::workerMain()
+{
+	std::unique_lock<std::mutex> lock{ mutex_ };
+	while (true) {
+		cond_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+		if (stop_) {
+			break;
+		}
+		auto task = std::move(tasks_.front());
+		tasks_.pop_front();
+		lock.unlock();
+		task();
+		lock.lock();
+	}
+}
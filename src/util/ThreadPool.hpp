@@ -0,0 +1,49 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include "../config.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+// A fixed set of worker threads that run queued tasks
+class ThreadPool final
+{
+public:
+	explicit ThreadPool(uint32_t threadCount);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator = (const ThreadPool&) = delete;
+
+	inline uint32_t threadCount() const { return uint32_t(threads_.size()); }
+
+	// Queues a task to run on one of the workers
+	void submit(std::function<void()> task);
+	// Runs the function for each index in [0, count), spread over the calling thread and the workers, and returns
+	// once all indices are complete. This is safe to call from tasks running in the pool.
+	void parallelFor(size_t count, const std::function<void(size_t)>& func);
+
+	// The pool shared by the library, sized to the hardware, which is created on first use
+	static ThreadPool& Shared();
+
+private:
+	void workerMain();
+
+private:
+	std::vector<std::thread> threads_;
+	std::mutex mutex_;
+	std::condition_variable cond_;
+	std::deque<std::function<void()>> tasks_;
+	bool stop_;
+}; // class ThreadPool
@@ -0,0 +1,123 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+// Regression checks for the block compression encoders
+
+#include "./Checks.hpp"
+#include "image/BlockCompress.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+
+// ====================================================================================================================
+// Decodes a BC1 block in four color mode
+static void DecodeBC1(const uint8_t* block, uint8_t* rgba)
+{
+	uint32_t palette[4][3];
+	for (uint32_t ei = 0; ei < 2; ++ei) {
+		const uint32_t packed = uint32_t(block[2 * ei]) | (uint32_t(block[(2 * ei) + 1]) << 8);
+		const uint32_t r = (packed >> 11) & 0x1F, g = (packed >> 5) & 0x3F, b = packed & 0x1F;
+		palette[ei][0] = (r << 3) | (r >> 2);
+		palette[ei][1] = (g << 2) | (g >> 4);
+		palette[ei][2] = (b << 3) | (b >> 2);
+	}
+	for (uint32_t ch = 0; ch < 3; ++ch) {
+		palette[2][ch] = ((2 * palette[0][ch]) + palette[1][ch]) / 3;
+		palette[3][ch] = (palette[0][ch] + (2 * palette[1][ch])) / 3;
+	}
+	uint32_t bits;
+	std::memcpy(&bits, block + 4, 4);
+	for (uint32_t pi = 0; pi < 16; ++pi) {
+		const uint32_t index = (bits >> (2 * pi)) & 0x3;
+		for (uint32_t ch = 0; ch < 3; ++ch) {
+			rgba[(pi * 4) + ch] = uint8_t(palette[index][ch]);
+		}
+		rgba[(pi * 4) + 3] = 255;
+	}
+}
+
+// ====================================================================================================================
+// Decodes a mode 6 BC7 block, returns false for other modes
+static bool DecodeBC7(const uint8_t* block, uint8_t* rgba)
+{
+	static constexpr uint32_t WEIGHTS[16]{ 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+	uint32_t position = 0;
+	const auto read = [block, &position](uint32_t bits) {
+		uint32_t value = 0;
+		for (uint32_t bi = 0; bi < bits; ++bi, ++position) {
+			value |= uint32_t((block[position >> 3] >> (position & 7)) & 1) << bi;
+		}
+		return value;
+	};
+	if (read(7) != (1 << 6)) {
+		return false;
+	}
+	uint32_t endpoints[2][4];
+	for (uint32_t ch = 0; ch < 4; ++ch) {
+		endpoints[0][ch] = read(7) << 1;
+		endpoints[1][ch] = read(7) << 1;
+	}
+	const uint32_t p0 = read(1), p1 = read(1);
+	for (uint32_t ch = 0; ch < 4; ++ch) {
+		endpoints[0][ch] |= p0;
+		endpoints[1][ch] |= p1;
+	}
+	for (uint32_t pi = 0; pi < 16; ++pi) {
+		const uint32_t weight = WEIGHTS[read((pi == 0) ? 3 : 4)];
+		for (uint32_t ch = 0; ch < 4; ++ch) {
+			rgba[(pi * 4) + ch] = uint8_t((((64 - weight) * endpoints[0][ch]) + (weight * endpoints[1][ch]) + 32) >> 6);
+		}
+	}
+	return true;
+}
+
+// ====================================================================================================================
+static uint32_t MaxError(const uint8_t* a, const uint8_t* b, size_t count)
+{
+	uint32_t error = 0;
+	for (size_t i = 0; i < count; ++i) {
+		error = std::max(error, uint32_t(std::abs(int32_t(a[i]) - int32_t(b[i]))));
+	}
+	return error;
+}
+
+// ====================================================================================================================
+// Channels that vary equally in opposite directions have no variance along the covariance diagonal, which used to
+// collapse the principal axis and encode the block as one flat color
+static void CheckOpposedChannels()
+{
+	uint8_t checker[64];
+	for (uint32_t pi = 0; pi < 16; ++pi) {
+		const bool red = (((pi & 3) + (pi >> 2)) & 1) == 0;
+		checker[(pi * 4) + 0] = red ? 255 : 0;
+		checker[(pi * 4) + 1] = red ? 0 : 255;
+		checker[(pi * 4) + 2] = 0;
+		checker[(pi * 4) + 3] = 255;
+	}
+
+	uint8_t bc1[8], decoded[64];
+	BlockCompress::Compress(checker, 4, 4, TextureFormat::BC1, 0, bc1);
+	CHECK(std::memcmp(bc1, bc1 + 2, 2) != 0);
+	DecodeBC1(bc1, decoded);
+	CHECK(MaxError(checker, decoded, 64) == 0);
+
+	uint8_t bc7[16];
+	for (uint32_t quality = 0; quality <= ImageCompressOptions::MAX_QUALITY; ++quality) {
+		BlockCompress::Compress(checker, 4, 4, TextureFormat::BC7, quality, bc7);
+		CHECK(DecodeBC7(bc7, decoded));
+		CHECK(MaxError(checker, decoded, 64) <= 1);
+	}
+}
+
+
+// ====================================================================================================================
+void CheckBlockCompress()
+{
+	CheckOpposedChannels();
+}
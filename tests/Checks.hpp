@@ -0,0 +1,27 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+
+
+// The number of failed checks in the run
+extern uint32_t Failures;
+
+#define CHECK(expr) \
+	do { \
+		if (!(expr)) { \
+			std::printf("FAILED: %s (%s:%d)\n", #expr, __FILE__, __LINE__); \
+			++Failures; \
+		} \
+	} while (false)
+
+
+// The check groups, one for each test file
+void CheckBlockCompress();
+void CheckRealtime();
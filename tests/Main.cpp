@@ -0,0 +1,27 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+// Runs all of the regression checks, returns non-zero if any check fails
+
+#include "./Checks.hpp"
+
+
+uint32_t Failures{ 0 };
+
+
+// ====================================================================================================================
+int main()
+{
+	CheckBlockCompress();
+	CheckRealtime();
+
+	if (Failures != 0) {
+		std::printf("%u check(s) failed\n", Failures);
+		return 1;
+	}
+	std::printf("All checks passed\n");
+	return 0;
+}
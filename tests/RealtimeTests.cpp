@@ -0,0 +1,239 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+// Regression checks for real-time audio handles
+// The tests program is built with VEGA_REALTIME_CHECKS, so any heap use inside of the reads and seeks of a real-time
+// handle aborts the program with a message naming the heap operation
+
+#include "./Checks.hpp"
+#include "./VorbisTone.hpp"
+#include "audio/AudioFile.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+static constexpr uint32_t SAMPLE_RATE{ 8000 };
+static constexpr uint32_t CHANNELS{ 2 };
+static constexpr uint64_t FRAME_COUNT{ 16000 };
+static constexpr uint32_t FLAC_BLOCK_FRAMES{ 1024 };
+static constexpr uint64_t READ_FRAMES{ 700 };
+static constexpr uint64_t SEEK_FRAME{ 9001 };
+
+
+// ====================================================================================================================
+// Appends a value with the given byte count and byte order
+static void Put(std::vector<uint8_t>* data, uint64_t value, uint32_t bytes, bool bigEndian)
+{
+	for (uint32_t bi = 0; bi < bytes; ++bi) {
+		const uint32_t shift = 8 * (bigEndian ? (bytes - bi - 1) : bi);
+		data->push_back(uint8_t(value >> shift));
+	}
+}
+
+// ====================================================================================================================
+// Appends a tag of four characters
+static void PutTag(std::vector<uint8_t>* data, const char* tag)
+{
+	data->insert(data->end(), tag, tag + 4);
+}
+
+// ====================================================================================================================
+// FLAC frame header and frame checksums
+static uint32_t FlacCrc(const uint8_t* data, size_t size, uint32_t bits, uint32_t poly)
+{
+	const uint32_t top = 1u << (bits - 1), mask = (top << 1) - 1;
+	uint32_t crc = 0;
+	for (size_t bi = 0; bi < size; ++bi) {
+		crc ^= uint32_t(data[bi]) << (bits - 8);
+		for (uint32_t si = 0; si < 8; ++si) {
+			crc = ((crc & top) ? ((crc << 1) ^ poly) : (crc << 1)) & mask;
+		}
+	}
+	return crc;
+}
+
+// ====================================================================================================================
+// Generates a stereo tone, as interleaved samples
+static std::vector<int16_t> MakeTone()
+{
+	std::vector<int16_t> samples(size_t(FRAME_COUNT * CHANNELS));
+	for (uint64_t fi = 0; fi < FRAME_COUNT; ++fi) {
+		const double value = std::sin(double(fi) * 2 * 3.14159265358979 * 440 / SAMPLE_RATE) * 16000;
+		samples[size_t(fi * CHANNELS)] = int16_t(value);
+		samples[size_t((fi * CHANNELS) + 1)] = int16_t(-value / 2);
+	}
+	return samples;
+}
+
+// ====================================================================================================================
+// Encodes the samples as a 16-bit PCM WAV file
+static std::vector<uint8_t> MakeWav(const std::vector<int16_t>& samples)
+{
+	const uint32_t dataSize = uint32_t(samples.size() * sizeof(int16_t));
+	std::vector<uint8_t> data;
+	PutTag(&data, "RIFF");
+	Put(&data, 36 + dataSize, 4, false);
+	PutTag(&data, "WAVE");
+	PutTag(&data, "fmt ");
+	Put(&data, 16, 4, false);
+	Put(&data, 1, 2, false);
+	Put(&data, CHANNELS, 2, false);
+	Put(&data, SAMPLE_RATE, 4, false);
+	Put(&data, SAMPLE_RATE * CHANNELS * sizeof(int16_t), 4, false);
+	Put(&data, CHANNELS * sizeof(int16_t), 2, false);
+	Put(&data, 16, 2, false);
+	PutTag(&data, "data");
+	Put(&data, dataSize, 4, false);
+	for (const auto sample : samples) {
+		Put(&data, uint16_t(sample), 2, false);
+	}
+	return data;
+}
+
+// ====================================================================================================================
+// Encodes the samples as a FLAC file with verbatim (uncompressed) subframes
+static std::vector<uint8_t> MakeFlac(const std::vector<int16_t>& samples)
+{
+	std::vector<uint8_t> data;
+	PutTag(&data, "fLaC");
+
+	// The stream info, as the last metadata block (the MD5 signature is left unset)
+	Put(&data, 0x80, 1, true);
+	Put(&data, 34, 3, true);
+	Put(&data, FLAC_BLOCK_FRAMES, 2, true);
+	Put(&data, FLAC_BLOCK_FRAMES, 2, true);
+	Put(&data, 0, 6, true);
+	Put(&data, (uint64_t(SAMPLE_RATE) << 44) | (uint64_t(CHANNELS - 1) << 41) | (uint64_t(15) << 36) | FRAME_COUNT, 8,
+		true);
+	Put(&data, 0, 8, true);
+	Put(&data, 0, 8, true);
+
+	// Frames with explicit 16-bit block sizes, the frame numbers are all below 128 and encode as one byte
+	for (uint64_t first = 0, number = 0; first < FRAME_COUNT; first += FLAC_BLOCK_FRAMES, ++number) {
+		const uint64_t frames = std::min(uint64_t(FLAC_BLOCK_FRAMES), FRAME_COUNT - first);
+		const size_t start = data.size();
+		Put(&data, 0xFFF8, 2, true);
+		Put(&data, 0x70, 1, true);
+		Put(&data, ((CHANNELS - 1) << 4) | 0x08, 1, true);
+		Put(&data, number, 1, true);
+		Put(&data, frames - 1, 2, true);
+		Put(&data, FlacCrc(data.data() + start, data.size() - start, 8, 0x07), 1, true);
+		for (uint32_t ci = 0; ci < CHANNELS; ++ci) {
+			Put(&data, 0x02, 1, true);
+			for (uint64_t fi = first; fi < (first + frames); ++fi) {
+				Put(&data, uint16_t(samples[size_t((fi * CHANNELS) + ci)]), 2, true);
+			}
+		}
+		Put(&data, FlacCrc(data.data() + start, data.size() - start, 16, 0x8005), 2, true);
+	}
+	return data;
+}
+
+// ====================================================================================================================
+static bool WriteFile(const std::string& path, const uint8_t* data, size_t size)
+{
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file.write(reinterpret_cast<const char*>(data), std::streamsize(size));
+	return file.good();
+}
+
+// ====================================================================================================================
+// Checks if the frames match the expected samples, starting at the given frame and stepping forward or backward
+static bool Matches(const int16_t* frames, uint64_t count, const std::vector<int16_t>& expected, uint64_t first,
+	bool reverse)
+{
+	for (uint64_t fi = 0; fi < count; ++fi) {
+		const uint64_t frame = reverse ? (first - fi) : (first + fi);
+		for (uint32_t ci = 0; ci < CHANNELS; ++ci) {
+			if (frames[(fi * CHANNELS) + ci] != expected[size_t((frame * CHANNELS) + ci)]) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+// ====================================================================================================================
+// Reads and seeks through a real-time handle, and compares the frames for lossless handles (expected is not NULL)
+static void CheckHandle(const char* name, AudioFile* file, const std::vector<int16_t>* expected)
+{
+	const uint32_t failures = Failures;
+	CHECK(!file->hasError() && (file->info().totalFrames == FRAME_COUNT) && (file->info().channels == CHANNELS));
+	CHECK(file->setRealtime(true));
+	if (Failures != failures) {
+		std::printf("  (%s handle)\n", name);
+		return;
+	}
+
+	std::vector<int16_t> buffer(size_t(READ_FRAMES * CHANNELS));
+	CHECK(file->readFrames(READ_FRAMES, buffer.data()) == READ_FRAMES);
+	CHECK(!expected || Matches(buffer.data(), READ_FRAMES, *expected, 0, false));
+	CHECK(file->seek(SEEK_FRAME));
+	CHECK(file->readFrames(READ_FRAMES, buffer.data()) == READ_FRAMES);
+	CHECK(!expected || Matches(buffer.data(), READ_FRAMES, *expected, SEEK_FRAME, false));
+	CHECK(file->readFramesReverse(READ_FRAMES, buffer.data()) == READ_FRAMES);
+	CHECK(!expected || Matches(buffer.data(), READ_FRAMES, *expected, SEEK_FRAME + READ_FRAMES - 1, true));
+	CHECK(file->remaining() == (FRAME_COUNT - SEEK_FRAME));
+
+	// Reads that reach the end of the file, and the recovery by seeking
+	CHECK(file->seek(FRAME_COUNT - 100));
+	CHECK(file->readFrames(READ_FRAMES, buffer.data()) == 100);
+	CHECK(file->readFrames(READ_FRAMES, buffer.data()) == 0);
+	CHECK(file->seek(0));
+	CHECK(file->readFramesReverse(READ_FRAMES, buffer.data()) == 0);
+	CHECK(file->seek(READ_FRAMES));
+	CHECK(file->readFramesReverse(READ_FRAMES, buffer.data()) == READ_FRAMES);
+	CHECK(!expected || Matches(buffer.data(), READ_FRAMES, *expected, READ_FRAMES - 1, true));
+
+	if (Failures != failures) {
+		std::printf("  (%s handle)\n", name);
+	}
+}
+
+// ====================================================================================================================
+void CheckRealtime()
+{
+	// The files are written to the working directory
+	const auto samples = MakeTone();
+	const auto wav = MakeWav(samples);
+	const auto flac = MakeFlac(samples);
+	static const std::string WAV_PATH{ "realtime_check.wav" };
+	static const std::string FLAC_PATH{ "realtime_check.flac" };
+	static const std::string VORBIS_PATH{ "realtime_check.ogg" };
+	const bool written = WriteFile(WAV_PATH, wav.data(), wav.size()) &&
+		WriteFile(FLAC_PATH, flac.data(), flac.size()) &&
+		WriteFile(VORBIS_PATH, VORBIS_TONE, sizeof(VORBIS_TONE));
+	CHECK(written);
+
+	if (written) {
+		{
+			AudioFile file{ WAV_PATH };
+			CheckHandle("WAV", &file, &samples);
+		}
+		{
+			AudioFile file{ FLAC_PATH };
+			CheckHandle("FLAC", &file, &samples);
+		}
+		{
+			AudioFile file{ VORBIS_PATH };
+			CheckHandle("Vorbis", &file, nullptr);
+		}
+		{
+			AudioFile file{ WAV_PATH };
+			CHECK(file.makeResident(AudioResidency::IMA_ADPCM));
+			CheckHandle("IMA ADPCM resident", &file, nullptr);
+		}
+	}
+
+	std::remove(WAV_PATH.c_str());
+	std::remove(FLAC_PATH.c_str());
+	std::remove(VORBIS_PATH.c_str());
+}
@@ -0,0 +1,326 @@
+/*
+ * MIT License - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the MIT License, the text of which can be found in the
+ * 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+
+// A 2 second, 8 kHz stereo Ogg/Vorbis file of a 440 Hz tone, as there is no Vorbis encoder to generate one with
+static const uint8_t VORBIS_TONE[]{
+	0x4f, 0x67, 0x67, 0x53, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xdc, 0x1f,
+	0xf3, 0x28, 0x00, 0x00, 0x00, 0x00, 0xec, 0x93, 0x32, 0x0b, 0x01, 0x1e, 0x01, 0x76, 0x6f, 0x72,
+	0x62, 0x69, 0x73, 0x00, 0x00, 0x00, 0x00, 0x02, 0x40, 0x1f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x30, 0x8e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x99, 0x01, 0x4f, 0x67, 0x67, 0x53, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xdc, 0x1f, 0xf3, 0x28, 0x01, 0x00, 0x00, 0x00,
+	0x78, 0x1f, 0x4d, 0xc8, 0x0c, 0x5a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0x5d, 0x03, 0x76, 0x6f, 0x72, 0x62, 0x69, 0x73, 0x34, 0x00, 0x00, 0x00, 0x58, 0x69, 0x70, 0x68,
+	0x2e, 0x4f, 0x72, 0x67, 0x20, 0x6c, 0x69, 0x62, 0x56, 0x6f, 0x72, 0x62, 0x69, 0x73, 0x20, 0x49,
+	0x20, 0x32, 0x30, 0x32, 0x30, 0x30, 0x37, 0x30, 0x34, 0x20, 0x28, 0x52, 0x65, 0x64, 0x75, 0x63,
+	0x69, 0x6e, 0x67, 0x20, 0x45, 0x6e, 0x76, 0x69, 0x72, 0x6f, 0x6e, 0x6d, 0x65, 0x6e, 0x74, 0x29,
+	0x01, 0x00, 0x00, 0x00, 0x12, 0x00, 0x00, 0x00, 0x45, 0x4e, 0x43, 0x4f, 0x44, 0x45, 0x52, 0x3d,
+	0x6c, 0x69, 0x62, 0x73, 0x6e, 0x64, 0x66, 0x69, 0x6c, 0x65, 0x01, 0x05, 0x76, 0x6f, 0x72, 0x62,
+	0x69, 0x73, 0x11, 0x42, 0x43, 0x56, 0x01, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x52, 0x14, 0x21, 0x25,
+	0x19, 0x53, 0x4a, 0x63, 0x08, 0x95, 0x52, 0x52, 0x29, 0x05, 0x1d, 0x63, 0x50, 0x5b, 0x47, 0x1d,
+	0x63, 0xd4, 0x39, 0x46, 0x21, 0x64, 0x10, 0x53, 0x88, 0x49, 0x19, 0xa5, 0x7b, 0x4f, 0x2a, 0x95,
+	0x58, 0x4a, 0xc8, 0x11, 0x52, 0x58, 0x29, 0x45, 0x1d, 0x53, 0x4c, 0x53, 0x49, 0x95, 0x52, 0x96,
+	0x29, 0x45, 0x1d, 0x63, 0x14, 0x53, 0x48, 0x21, 0x53, 0xd6, 0x31, 0x65, 0xa1, 0x73, 0x14, 0x4b,
+	0x86, 0x49, 0x09, 0x25, 0x6c, 0x4d, 0xae, 0x74, 0x16, 0x4b, 0xe8, 0x99, 0x63, 0x96, 0x31, 0x46,
+	0x1d, 0x63, 0xce, 0x5a, 0x4a, 0x9d, 0x63, 0xd6, 0x31, 0x45, 0x1d, 0x63, 0x52, 0x52, 0x49, 0xa1,
+	0x73, 0x18, 0x3a, 0x66, 0x25, 0x64, 0x14, 0x3a, 0x46, 0xc5, 0xe8, 0x62, 0x7c, 0x30, 0x3a, 0x95,
+	0xa2, 0x42, 0x28, 0xbe, 0xc7, 0xde, 0x52, 0xe9, 0x2d, 0x85, 0x8a, 0x5b, 0x8a, 0xbd, 0xd7, 0x1a,
+	0x53, 0xeb, 0x2d, 0x84, 0x18, 0x4b, 0x69, 0xc1, 0x08, 0x61, 0x73, 0xed, 0xb5, 0xd5, 0xdc, 0x4a,
+	0x6a, 0xc5, 0x18, 0x63, 0x8c, 0x31, 0xc6, 0xc5, 0xe2, 0x53, 0x28, 0x82, 0xd0, 0x90, 0x55, 0x00,
+	0x00, 0x01, 0x00, 0x00, 0x40, 0x04, 0x01, 0x42, 0x43, 0x56, 0x01, 0x00, 0x0a, 0x00, 0x00, 0xc2,
+	0x50, 0x0c, 0x45, 0x51, 0x80, 0xd0, 0x90, 0x55, 0x00, 0x40, 0x06, 0x00, 0x80, 0x00, 0x14, 0x45,
+	0x71, 0x14, 0xc7, 0x71, 0x1c, 0x47, 0x92, 0x24, 0xcb, 0x02, 0x42, 0x43, 0x56, 0x01, 0x00, 0x40,
+	0x00, 0x00, 0x02, 0x00, 0x00, 0x28, 0x8e, 0xe1, 0x28, 0x92, 0x23, 0x49, 0x92, 0x64, 0x59, 0x96,
+	0x65, 0x59, 0x96, 0xa6, 0x79, 0x96, 0xa8, 0xb9, 0xaa, 0x2f, 0xfb, 0xae, 0x2e, 0xeb, 0xae, 0xed,
+	0xea, 0xba, 0x0e, 0x84, 0x86, 0xac, 0x04, 0x00, 0xc8, 0x00, 0x00, 0x18, 0x25, 0x1e, 0x75, 0x0e,
+	0x42, 0x69, 0x8c, 0x48, 0x10, 0x29, 0xe6, 0xa4, 0x18, 0x63, 0x84, 0x10, 0x42, 0x08, 0x0d, 0x81,
+	0x45, 0x15, 0x73, 0xd0, 0x5a, 0x08, 0xae, 0x73, 0x50, 0x4a, 0xcc, 0x10, 0x58, 0xce, 0x20, 0xe5,
+	0xa4, 0x42, 0x60, 0x39, 0x64, 0x10, 0x83, 0x8c, 0x81, 0x07, 0x15, 0x42, 0xca, 0x39, 0x07, 0x22,
+	0x75, 0x4a, 0x29, 0x06, 0x25, 0xb8, 0x56, 0x42, 0xc6, 0x1c, 0x10, 0x1a, 0xb2, 0x42, 0x00, 0x08,
+	0xcd, 0x00, 0x30, 0x48, 0x12, 0x20, 0x69, 0x1a, 0x20, 0x69, 0x1a, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x48, 0x9e, 0x06, 0x68, 0x9e, 0x08, 0x68, 0x9e, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x92, 0xe6, 0x01, 0x9a, 0xe8, 0x01, 0x9a, 0xe8, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x79,
+	0x1e, 0xe0, 0x89, 0x22, 0xe0, 0x89, 0x22, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x68, 0xa2,
+	0x08, 0x78, 0x9e, 0x09, 0x88, 0xa6, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x9a, 0x28,
+	0x02, 0x9e, 0x29, 0x02, 0xa2, 0x69, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x79, 0x1e, 0xe0, 0x89, 0x22,
+	0xe0, 0x89, 0x22, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x68, 0xa2, 0x08, 0x88, 0xa6, 0x09,
+	0x78, 0xa2, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x9a, 0x28, 0x02, 0xa2, 0x69, 0x02,
+	0x9e, 0xe9, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x08, 0x70, 0x00, 0x00,
+	0x08, 0xb0, 0x10, 0x0a, 0x0d, 0x59, 0x11, 0x00, 0xc4, 0x09, 0x00, 0x38, 0x1c, 0x47, 0x92, 0x00,
+	0x00, 0xc0, 0x71, 0x1c, 0xcb, 0x02, 0x00, 0x00, 0xc7, 0x71, 0x2c, 0x0b, 0x00, 0x00, 0x2c, 0xcb,
+	0xd2, 0x34, 0x00, 0x00, 0xb0, 0x2c, 0x4b, 0xd3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x0c, 0x38, 0x00, 0x00,
+	0x04, 0x98, 0x50, 0x06, 0x0a, 0x0d, 0x59, 0x09, 0x00, 0x44, 0x01, 0x00, 0x18, 0x0c, 0x45, 0xd3,
+	0x00, 0x96, 0x05, 0xb0, 0x2c, 0x80, 0xa6, 0x01, 0x34, 0x0d, 0xe0, 0x79, 0x00, 0xd1, 0x03, 0x98,
+	0x26, 0x00, 0x10, 0x00, 0x00, 0x50, 0xe0, 0x00, 0x00, 0x10, 0x60, 0x83, 0xa6, 0xc4, 0xe2, 0x00,
+	0x85, 0x86, 0xac, 0x04, 0x00, 0xa2, 0x00, 0x00, 0x0c, 0x8a, 0xe2, 0x48, 0x96, 0xe5, 0x79, 0xf0,
+	0x3c, 0x4d, 0x13, 0x45, 0x78, 0x9e, 0xa6, 0x89, 0x22, 0x44, 0xd3, 0xf3, 0x44, 0x11, 0xa6, 0xe9,
+	0x79, 0xa2, 0x08, 0xd5, 0xf4, 0x3c, 0xd3, 0x84, 0xaa, 0x7a, 0x9e, 0x69, 0xc2, 0x75, 0x45, 0xd1,
+	0x34, 0x81, 0x28, 0x9a, 0xa6, 0x00, 0x00, 0x80, 0x02, 0x07, 0x00, 0x80, 0x00, 0x1b, 0x34, 0x25,
+	0x16, 0x07, 0x28, 0x34, 0x64, 0x25, 0x00, 0x10, 0x12, 0x00, 0x60, 0x50, 0x14, 0x49, 0xf2, 0x3c,
+	0xcf, 0x13, 0x45, 0xd3, 0x54, 0x55, 0x55, 0x85, 0xe7, 0x79, 0x9e, 0x28, 0x8a, 0xa2, 0x69, 0xaa,
+	0xaa, 0xeb, 0xc2, 0xf3, 0x3c, 0x4f, 0x14, 0x45, 0xd1, 0x34, 0x55, 0xd5, 0x75, 0x21, 0x8a, 0x9e,
+	0x67, 0x9a, 0xa6, 0xa9, 0xaa, 0xae, 0xeb, 0xba, 0x10, 0x45, 0xcf, 0x33, 0x4d, 0xd3, 0x54, 0x55,
+	0xd7, 0x75, 0x5d, 0x98, 0xa6, 0x28, 0x9a, 0xa6, 0x69, 0xaa, 0xaa, 0xeb, 0xca, 0x32, 0x4c, 0x53,
+	0x14, 0x4d, 0xd3, 0x34, 0x55, 0xd5, 0x75, 0x65, 0x19, 0xaa, 0x2a, 0x8a, 0xa6, 0x69, 0x9a, 0xaa,
+	0xea, 0xba, 0xb2, 0x0c, 0x44, 0xd1, 0x34, 0x4d, 0x53, 0x55, 0x5d, 0x57, 0x96, 0x81, 0x28, 0x9a,
+	0xa6, 0xaa, 0xba, 0xae, 0xeb, 0xca, 0x32, 0x10, 0x45, 0xd3, 0x54, 0x55, 0x57, 0x75, 0x5d, 0x59,
+	0x06, 0xa6, 0xa9, 0xaa, 0xaa, 0xea, 0xba, 0xb2, 0x2b, 0xcb, 0x00, 0xd5, 0x54, 0x55, 0xd7, 0x95,
+	0x65, 0x59, 0x06, 0xa8, 0xaa, 0xeb, 0xba, 0xae, 0x2c, 0xcb, 0x36, 0x40, 0x55, 0x5d, 0xd7, 0x75,
+	0x65, 0xd9, 0x96, 0x01, 0xae, 0xeb, 0xba, 0xb2, 0x2c, 0xcb, 0xb6, 0x0d, 0xc0, 0x75, 0x65, 0x59,
+	0x96, 0x6d, 0x5b, 0x00, 0x00, 0xc0, 0x81, 0x03, 0x00, 0x40, 0x80, 0x11, 0x74, 0x92, 0x51, 0x65,
+	0x11, 0x36, 0x9a, 0x70, 0xe1, 0x01, 0x28, 0x34, 0x64, 0x45, 0x00, 0x10, 0x05, 0x00, 0x00, 0x18,
+	0xa3, 0x94, 0x62, 0x4a, 0x19, 0xc6, 0x24, 0x84, 0x12, 0x42, 0xc4, 0x98, 0x84, 0x50, 0x42, 0xa8,
+	0xa4, 0x94, 0x52, 0x52, 0x29, 0x15, 0x84, 0x12, 0x4a, 0x2a, 0xa5, 0x82, 0x50, 0x42, 0x48, 0xa1,
+	0x64, 0x52, 0x52, 0x4a, 0xa9, 0x94, 0x0a, 0x42, 0x29, 0x25, 0x85, 0x50, 0x41, 0x28, 0xa5, 0x94,
+	0x10, 0x0a, 0x00, 0x00, 0x3b, 0x70, 0x00, 0x00, 0x3b, 0xb0, 0x10, 0x0a, 0x0d, 0x59, 0x09, 0x00,
+	0xe4, 0x01, 0x00, 0x10, 0x84, 0x20, 0xc4, 0x18, 0x63, 0x8c, 0x49, 0x09, 0x19, 0x63, 0xcc, 0x39,
+	0xe7, 0x20, 0x84, 0x8c, 0x31, 0xe6, 0x9c, 0x73, 0x52, 0x4a, 0xc6, 0x18, 0x73, 0xce, 0x39, 0x29,
+	0x25, 0x63, 0x8c, 0x39, 0xe7, 0x9c, 0x94, 0xd2, 0x39, 0xe7, 0x9c, 0x73, 0x4e, 0x4a, 0xe9, 0x9c,
+	0x73, 0xce, 0x39, 0x27, 0xa5, 0x74, 0xce, 0x39, 0xe7, 0x9c, 0x93, 0x52, 0x4a, 0xe9, 0x9c, 0x73,
+	0xce, 0x49, 0x29, 0xa5, 0x74, 0xce, 0x39, 0xe7, 0xa4, 0x94, 0x52, 0x3a, 0xe7, 0x9c, 0x73, 0x02,
+	0x00, 0x80, 0x0a, 0x1c, 0x00, 0x00, 0x02, 0x6c, 0x14, 0xd9, 0x9c, 0x60, 0x24, 0xa8, 0xd0, 0x90,
+	0x95, 0x00, 0x40, 0x2a, 0x00, 0x80, 0xc1, 0x71, 0x2c, 0xcb, 0xf3, 0x3c, 0x4f, 0x14, 0x4d, 0x53,
+	0x93, 0x24, 0x4d, 0xf3, 0x3c, 0xcf, 0x13, 0x4d, 0x55, 0xd5, 0x24, 0x49, 0xd3, 0x3c, 0x4f, 0x14,
+	0x4d, 0x53, 0x55, 0x79, 0x9e, 0xe7, 0x89, 0xa2, 0x28, 0x8a, 0xa6, 0xaa, 0xf2, 0x3c, 0xcf, 0x13,
+	0x45, 0x51, 0x34, 0x4d, 0x55, 0xe5, 0xba, 0xa2, 0x28, 0x8a, 0xa6, 0x68, 0xaa, 0xaa, 0x4a, 0x76,
+	0x45, 0x4f, 0x14, 0x4d, 0x53, 0x55, 0x5d, 0x15, 0xa2, 0x28, 0x8a, 0xa6, 0xa9, 0xaa, 0xae, 0x0b,
+	0xd3, 0x14, 0x45, 0xd3, 0x54, 0x55, 0xd7, 0x85, 0x2c, 0x9b, 0xa6, 0xaa, 0xba, 0xaa, 0xec, 0xc2,
+	0xb6, 0x4d, 0x53, 0x35, 0x55, 0xd5, 0x75, 0x81, 0xeb, 0xaa, 0xaa, 0xeb, 0xca, 0x32, 0x70, 0x5d,
+	0xd5, 0x74, 0x55, 0xd9, 0x15, 0x00, 0x00, 0x9e, 0xe0, 0x00, 0x00, 0x54, 0x60, 0xc3, 0xea, 0x08,
+	0x27, 0x45, 0x63, 0x81, 0x85, 0x86, 0xac, 0x04, 0x00, 0x32, 0x00, 0x00, 0x08, 0x42, 0x10, 0x52,
+	0x4a, 0x21, 0xa4, 0x94, 0x42, 0x48, 0x29, 0x85, 0x90, 0x52, 0x0a, 0x21, 0x01, 0x00, 0x00, 0x03,
+	0x0e, 0x00, 0x00, 0x01, 0x26, 0x94, 0x81, 0x42, 0x43, 0x56, 0x02, 0x00, 0xa9, 0x00, 0x00, 0x00,
+	0x21, 0x52, 0x4a, 0x29, 0xa5, 0x94, 0x52, 0x22, 0xa5, 0xa4, 0x94, 0x52, 0x4a, 0x29, 0xa5, 0x54,
+	0xcc, 0x49, 0x29, 0xa5, 0x94, 0x52, 0x4a, 0x29, 0xa5, 0x94, 0x52, 0x4a, 0x29, 0xa5, 0x94, 0x52,
+	0x4a, 0x29, 0xa5, 0x94, 0x52, 0x4a, 0x29, 0xa5, 0x94, 0x52, 0x4a, 0x29, 0xa5, 0x94, 0x52, 0x4a,
+	0x29, 0xa5, 0x94, 0x52, 0x4a, 0x29, 0xa5, 0x94, 0x52, 0x4a, 0x29, 0xa5, 0x94, 0x52, 0x4a, 0x29,
+	0xa5, 0x94, 0x52, 0x4a, 0x29, 0xa5, 0x94, 0x52, 0x4a, 0x29, 0xa5, 0x94, 0x52, 0x4a, 0x29, 0xa5,
+	0x94, 0x52, 0x4a, 0x29, 0xa5, 0x94, 0x52, 0x4a, 0x29, 0xa5, 0x94, 0x52, 0x4a, 0x29, 0xa5, 0x94,
+	0x52, 0x4a, 0x29, 0xa5, 0x94, 0x52, 0x42, 0x08, 0xa1, 0x00, 0x40, 0xec, 0x0a, 0x07, 0x80, 0x9d,
+	0x08, 0x1b, 0x56, 0x47, 0x38, 0x29, 0x1a, 0x0b, 0x2c, 0x34, 0x64, 0x25, 0x00, 0x10, 0x0e, 0x00,
+	0x00, 0x18, 0x83, 0x10, 0x63, 0x10, 0x52, 0x6a, 0x2d, 0xc6, 0x0a, 0x21, 0xa5, 0x20, 0x94, 0xd2,
+	0x5a, 0x8b, 0xb9, 0x56, 0x08, 0x31, 0x06, 0xa1, 0x94, 0xd6, 0x5a, 0xac, 0x31, 0x68, 0xcc, 0x39,
+	0x29, 0x29, 0xb5, 0x18, 0x63, 0x8c, 0x41, 0x63, 0xce, 0x49, 0x49, 0x29, 0xc6, 0x18, 0x6b, 0x0d,
+	0x2a, 0x85, 0x90, 0x52, 0x6b, 0x2d, 0xc6, 0x9a, 0x63, 0x70, 0x2d, 0x84, 0x94, 0x5a, 0x8b, 0x31,
+	0xc6, 0xda, 0x83, 0x10, 0xaa, 0xb5, 0x16, 0x63, 0xac, 0xb9, 0xe6, 0x1c, 0x84, 0x70, 0x2d, 0xa5,
+	0x18, 0x6b, 0xcd, 0x35, 0xe7, 0x20, 0x84, 0xce, 0x31, 0xd6, 0x9a, 0x6b, 0xce, 0x3d, 0x07, 0x21,
+	0x74, 0x8e, 0x31, 0xd6, 0x9a, 0x73, 0xce, 0x3d, 0x08, 0x21, 0x7c, 0xcd, 0xb5, 0xe6, 0x5a, 0x73,
+	0xce, 0x41, 0x08, 0x21, 0x6c, 0xed, 0x35, 0xe7, 0x9c, 0x73, 0x0e, 0x42, 0x08, 0x21, 0x7c, 0xcf,
+	0x41, 0xe7, 0x1a, 0x74, 0xf0, 0x41, 0x08, 0xe1, 0x73, 0xcd, 0x39, 0xe7, 0x9c, 0x0b, 0x00, 0x30,
+	0x79, 0x70, 0x00, 0x80, 0x4a, 0xb0, 0x71, 0x86, 0x95, 0xa4, 0xb3, 0xc2, 0xd1, 0xe0, 0x42, 0x43,
+	0x56, 0x02, 0x00, 0xb9, 0x01, 0x00, 0x84, 0x31, 0x4a, 0x31, 0xe6, 0x9c, 0x73, 0xd0, 0x41, 0x08,
+	0x21, 0x84, 0x10, 0x52, 0x6a, 0x19, 0x63, 0xcc, 0x39, 0x08, 0x21, 0x94, 0x52, 0x4a, 0x29, 0xa5,
+	0xa4, 0x94, 0x32, 0xc6, 0x98, 0x73, 0xd0, 0x41, 0x08, 0x21, 0x84, 0x52, 0x4a, 0x49, 0xa9, 0x75,
+	0xce, 0x39, 0xe7, 0x20, 0x84, 0x50, 0x4a, 0x29, 0xa5, 0x94, 0x92, 0x52, 0xca, 0x98, 0x73, 0xce,
+	0x41, 0x08, 0xa1, 0x94, 0x52, 0x4a, 0x29, 0x25, 0xa5, 0xd4, 0x39, 0xe7, 0x20, 0x84, 0x10, 0x42,
+	0x29, 0xa5, 0x94, 0x52, 0x4a, 0x4a, 0xa9, 0x73, 0xce, 0x41, 0x08, 0x21, 0x84, 0x52, 0x4a, 0x29,
+	0xa5, 0x94, 0xd4, 0x52, 0x08, 0x1d, 0x84, 0x10, 0x42, 0x29, 0xa5, 0x94, 0x52, 0x4a, 0x29, 0x29,
+	0xa5, 0x94, 0x3a, 0x07, 0x21, 0x84, 0x52, 0x4a, 0x29, 0xa5, 0x94, 0x52, 0x52, 0x4b, 0x2d, 0x85,
+	0x10, 0x42, 0x28, 0xa5, 0x94, 0x52, 0x4a, 0x29, 0xa5, 0xa4, 0x94, 0x52, 0x0a, 0x21, 0x84, 0x52,
+	0x4a, 0x29, 0xa5, 0x94, 0x52, 0x4a, 0x69, 0xa9, 0xa5, 0x14, 0x42, 0x28, 0xa5, 0x94, 0x52, 0x4a,
+	0x29, 0xa5, 0x94, 0xd2, 0x52, 0x4a, 0x29, 0xa5, 0x52, 0x4a, 0x29, 0xa5, 0x94, 0x52, 0x4a, 0x29,
+	0x29, 0xa5, 0x96, 0x52, 0x4b, 0xa5, 0x94, 0x52, 0x4a, 0x29, 0xa5, 0x94, 0x92, 0x4a, 0x4a, 0x29,
+	0xa5, 0x94, 0x4a, 0x29, 0xa5, 0x94, 0x52, 0x4a, 0x29, 0xa5, 0x94, 0x94, 0x5a, 0x6a, 0x29, 0x95,
+	0x52, 0x4a, 0x29, 0xa5, 0x94, 0x52, 0x4a, 0x29, 0x29, 0xb5, 0xd4, 0x52, 0x4a, 0xa9, 0x94, 0x52,
+	0x4a, 0x29, 0xa5, 0x94, 0x52, 0x52, 0x6a, 0x29, 0xb5, 0x94, 0x5a, 0x29, 0xa9, 0x94, 0x52, 0x4a,
+	0x29, 0xa5, 0xa4, 0x94, 0x52, 0x4a, 0x29, 0xa5, 0x52, 0x4a, 0x29, 0xa5, 0x94, 0x52, 0x4a, 0x69,
+	0x2d, 0xb5, 0x94, 0x5a, 0x6b, 0x29, 0x95, 0x52, 0x4a, 0x29, 0xa5, 0x94, 0xd4, 0x5a, 0x6a, 0x2d,
+	0xb5, 0x94, 0x52, 0x2a, 0xa5, 0x94, 0x52, 0x4a, 0x29, 0xa5, 0x00, 0x00, 0xa0, 0x03, 0x07, 0x00,
+	0x80, 0x00, 0x23, 0x2a, 0x2d, 0xc4, 0x4e, 0x33, 0xae, 0x3c, 0x02, 0x47, 0x14, 0x32, 0x4c, 0x40,
+	0x01, 0x00, 0x00, 0x20, 0x00, 0x20, 0xc0, 0x04, 0x10, 0x18, 0x20, 0x28, 0x18, 0x85, 0x20, 0x40,
+	0x18, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x80, 0x0f, 0x00, 0x80, 0xa4, 0x00, 0x08,
+	0x88, 0x88, 0x66, 0xce, 0xe0, 0x00, 0x21, 0x41, 0x61, 0x81, 0xa1, 0xc1, 0xe1, 0x01, 0x22, 0x02,
+	0x00, 0x00, 0x10, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x4f, 0x67,
+	0x67, 0x53, 0x00, 0x04, 0x80, 0x3e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xdc, 0x1f, 0xf3, 0x28,
+	0x02, 0x00, 0x00, 0x00, 0x4f, 0xe9, 0x70, 0xcc, 0x40, 0x29, 0x1f, 0x1d, 0x20, 0x20, 0x1e, 0x20,
+	0x21, 0x1e, 0x1f, 0x20, 0x1f, 0x1f, 0x21, 0x1f, 0x1f, 0x21, 0x1f, 0x1f, 0x21, 0x1f, 0x1f, 0x21,
+	0x20, 0x1f, 0x21, 0x1f, 0x1d, 0x20, 0x20, 0x1e, 0x20, 0x21, 0x1e, 0x1f, 0x20, 0x1f, 0x1f, 0x21,
+	0x1f, 0x1f, 0x21, 0x1f, 0x1f, 0x21, 0x1f, 0x1f, 0x21, 0x20, 0x1f, 0x21, 0x1f, 0x1d, 0x20, 0x20,
+	0x1e, 0x20, 0x21, 0x1e, 0x1f, 0x20, 0x1f, 0x27, 0x43, 0x9e, 0x99, 0x99, 0x79, 0x95, 0x6c, 0x86,
+	0xca, 0xea, 0x50, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xfe, 0xdb, 0xd7, 0x0b, 0x00,
+	0xa8, 0xff, 0x6d, 0x68, 0x5d, 0xda, 0xb6, 0xa4, 0x75, 0x69, 0xef, 0xd3, 0x30, 0xd3, 0xdf, 0x3d,
+	0xb8, 0x00, 0xa6, 0x9a, 0x99, 0x73, 0x37, 0xcb, 0x67, 0xa8, 0x7a, 0x86, 0x22, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0xe0, 0xeb, 0xff, 0x0a, 0x00, 0xa0, 0xf4, 0xb9, 0x9c, 0xd5, 0x8e, 0xbe, 0x62,
+	0x03, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5, 0x33, 0x54, 0x3e, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0xe0, 0xbf, 0x1f, 0x00, 0x82, 0xd2, 0x07, 0x39, 0xed, 0x42, 0x4e, 0x03, 0xa6, 0x9a,
+	0x99, 0x73, 0xa7, 0xe5, 0x33, 0x54, 0x3d, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0,
+	0x37, 0xff, 0x03, 0x00, 0x40, 0xe9, 0xf3, 0x05, 0x39, 0xf5, 0xa3, 0x3e, 0xbf, 0x01, 0xa6, 0x9a,
+	0x99, 0x73, 0xa7, 0xe5, 0x33, 0x54, 0x3d, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac,
+	0xfe, 0x87, 0x5f, 0x2b, 0x00, 0x08, 0x2a, 0xc3, 0xe1, 0x60, 0xc5, 0xe1, 0xfb, 0x00, 0xa6, 0x9a,
+	0x99, 0x73, 0xa7, 0xe6, 0x33, 0x14, 0x3b, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac,
+	0xfe, 0xef, 0x56, 0x10, 0x14, 0x41, 0xc9, 0x8d, 0xac, 0x92, 0x3b, 0x00, 0xa6, 0x9a, 0x99, 0x73,
+	0xa7, 0xe5, 0x33, 0x54, 0x3d, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac, 0xfe, 0x87,
+	0xdf, 0x2b, 0x00, 0x08, 0xaa, 0xc3, 0x51, 0x51, 0xa2, 0xe1, 0x7b, 0x03, 0xa6, 0x9a, 0x99, 0x73,
+	0xa7, 0xe5, 0x33, 0x54, 0x3d, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac, 0xfe, 0xe6,
+	0x3f, 0xac, 0x00, 0x80, 0x68, 0xef, 0x2f, 0xb5, 0xf7, 0xe7, 0x7e, 0xb5, 0x1e, 0xa6, 0x9a, 0x99,
+	0x73, 0xa7, 0xe5, 0x33, 0x54, 0x3e, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xb0, 0xfe,
+	0x4f, 0x00, 0x50, 0x84, 0xde, 0xa2, 0x5f, 0x5e, 0xa0, 0xa7, 0x03, 0xa6, 0x9a, 0x99, 0x73, 0x37,
+	0xcb, 0x67, 0xa8, 0x7a, 0x86, 0x22, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0xeb, 0xff, 0x12,
+	0x00, 0x20, 0xf4, 0xbe, 0x9c, 0xb7, 0x8f, 0x39, 0x6c, 0x3d, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5,
+	0x33, 0x54, 0x3d, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac, 0xfe, 0xc7, 0xbf, 0x5d,
+	0x01, 0x40, 0x11, 0xdd, 0x86, 0x47, 0x4b, 0xdf, 0xba, 0x37, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe6,
+	0x33, 0x14, 0x3b, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac, 0xfe, 0x9f, 0xb3, 0x82,
+	0x22, 0x28, 0x42, 0xee, 0x34, 0x08, 0x2e, 0x37, 0x00, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5, 0x33,
+	0x54, 0x3d, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac, 0xfe, 0xa7, 0xd7, 0x0a, 0x00,
+	0x8a, 0x48, 0x73, 0x7c, 0xbc, 0x5b, 0xb3, 0x02, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5, 0x33, 0x54,
+	0x3d, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac, 0xfe, 0x1d, 0xff, 0x7e, 0x05, 0x00,
+	0x54, 0x5a, 0xaf, 0xe3, 0x8b, 0x81, 0xaf, 0x5d, 0x02, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5, 0x33,
+	0x54, 0x3e, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x70, 0xfe, 0x07, 0x00, 0x08, 0x4a,
+	0x9f, 0xde, 0x72, 0xe7, 0xb4, 0x7d, 0x4e, 0x03, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5, 0x33, 0x54,
+	0x3e, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xfa, 0x1f, 0x00, 0x00, 0x4a, 0x9f,
+	0x25, 0xe2, 0xae, 0x6c, 0xe9, 0x69, 0x00, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5, 0x33, 0x54, 0x3d,
+	0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac, 0xfe, 0xfd, 0xbf, 0x7d, 0x05, 0x00, 0x54,
+	0x5b, 0x8f, 0x25, 0xf0, 0x8f, 0xc7, 0x2d, 0x01, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe6, 0x33, 0x14,
+	0x3b, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac, 0xfe, 0xef, 0xaf, 0x15, 0x00, 0x04,
+	0xa5, 0x59, 0x8e, 0x59, 0xa7, 0xe6, 0x04, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe6, 0x33, 0x14, 0x3b,
+	0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac, 0xfe, 0xef, 0x67, 0x05, 0x41, 0x11, 0x94,
+	0x66, 0xd9, 0xea, 0x17, 0xcd, 0x29, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5, 0x33, 0x54, 0x3d, 0x43,
+	0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac, 0xfe, 0xfd, 0xdf, 0xae, 0x00, 0x80, 0x68, 0xdb,
+	0xb1, 0x74, 0x7a, 0xe0, 0xb8, 0xa5, 0x00, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5, 0x33, 0x54, 0x3d,
+	0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xfa, 0x1f, 0x01, 0xa0, 0x08, 0xbd, 0x37,
+	0xe8, 0x0a, 0x53, 0xad, 0x3f, 0x1d, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5, 0x33, 0x54, 0x3e, 0x43,
+	0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x70, 0xfe, 0x27, 0x00, 0x28, 0x42, 0xef, 0x36, 0x9d,
+	0x7c, 0xad, 0xd6, 0xd3, 0x01, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5, 0x33, 0x54, 0x3d, 0x43, 0x11,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac, 0xfe, 0xf6, 0x3f, 0xac, 0x00, 0x80, 0x48, 0xdb, 0xb3,
+	0x9c, 0x1f, 0xf2, 0x99, 0xf5, 0x00, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5, 0x33, 0x54, 0x3d, 0x43,
+	0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac, 0xfe, 0xc7, 0x9f, 0x59, 0x01, 0x40, 0x11, 0x6d,
+	0x8e, 0x47, 0xbe, 0x6b, 0xb6, 0x0d, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe6, 0x33, 0x14, 0x3b, 0x43,
+	0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac, 0xfe, 0x9f, 0x75, 0x05, 0x45, 0x50, 0x84, 0xdc,
+	0x69, 0xb0, 0x75, 0x6e, 0x00, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5, 0x33, 0x54, 0x3d, 0x43, 0x11,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac, 0xfe, 0xc7, 0xbf, 0x59, 0x01, 0x40, 0x11, 0x59, 0x98,
+	0x83, 0xf7, 0xea, 0x42, 0x7d, 0x00, 0xa6, 0x9a, 0x99, 0x73, 0x37, 0xcb, 0x67, 0xa8, 0x7a, 0x86,
+	0x22, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0xeb, 0xff, 0x0a, 0x00, 0xa0, 0xf4, 0xb9, 0x9c,
+	0xd5, 0x8e, 0xbe, 0x62, 0x03, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5, 0x33, 0x54, 0x3e, 0x43, 0x11,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0xbf, 0x1f, 0x00, 0x82, 0xd2, 0x07, 0x39, 0xed, 0x42,
+	0x4e, 0x03, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5, 0x33, 0x54, 0x3d, 0x43, 0x11, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0xf0, 0x37, 0xff, 0x03, 0x00, 0x40, 0xe9, 0xf3, 0x05, 0x39, 0xf5, 0xa3, 0x3e,
+	0xbf, 0x01, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5, 0x33, 0x54, 0x3d, 0x43, 0x11, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0xac, 0xfe, 0x87, 0x5f, 0x2b, 0x00, 0x08, 0x2a, 0xc3, 0xe1, 0x60, 0xc5, 0xe1,
+	0xfb, 0x00, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe6, 0x33, 0x14, 0x3b, 0x43, 0x11, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0xac, 0xfe, 0xef, 0x56, 0x10, 0x14, 0x41, 0xc9, 0x8d, 0xac, 0x92, 0x3b, 0x00,
+	0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5, 0x33, 0x54, 0x3d, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0xac, 0xfe, 0x87, 0xdf, 0x2b, 0x00, 0x08, 0xaa, 0xc3, 0x51, 0x51, 0xa2, 0xe1, 0x7b, 0x03,
+	0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5, 0x33, 0x54, 0x3d, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0xac, 0xfe, 0xe6, 0x3f, 0xac, 0x00, 0x80, 0x68, 0xef, 0x2f, 0xb5, 0xf7, 0xe7, 0x7e, 0xb5,
+	0x1e, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5, 0x33, 0x54, 0x3e, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0xb0, 0xfe, 0x4f, 0x00, 0x50, 0x84, 0xde, 0xa2, 0x5f, 0x5e, 0xa0, 0xa7, 0x03, 0xa6,
+	0x9a, 0x99, 0x73, 0x37, 0xcb, 0x67, 0xa8, 0x7a, 0x86, 0x22, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xe0, 0xeb, 0xff, 0x12, 0x00, 0x20, 0xf4, 0xbe, 0x9c, 0xb7, 0x8f, 0x39, 0x6c, 0x3d, 0xa6, 0x9a,
+	0x99, 0x73, 0xa7, 0xe5, 0x33, 0x54, 0x3d, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac,
+	0xfe, 0xc7, 0xbf, 0x5d, 0x01, 0x40, 0x11, 0xdd, 0x86, 0x47, 0x4b, 0xdf, 0xba, 0x37, 0xa6, 0x9a,
+	0x99, 0x73, 0xa7, 0xe6, 0x33, 0x14, 0x3b, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac,
+	0xfe, 0x9f, 0xb3, 0x82, 0x22, 0x28, 0x42, 0xee, 0x34, 0x08, 0x2e, 0x37, 0x00, 0xa6, 0x9a, 0x99,
+	0x73, 0xa7, 0xe5, 0x33, 0x54, 0x3d, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac, 0xfe,
+	0xa7, 0xd7, 0x0a, 0x00, 0x8a, 0x48, 0x73, 0x7c, 0xbc, 0x5b, 0xb3, 0x02, 0xa6, 0x9a, 0x99, 0x73,
+	0xa7, 0xe5, 0x33, 0x54, 0x3d, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac, 0xfe, 0x1d,
+	0xff, 0x7e, 0x05, 0x00, 0x54, 0x5a, 0xaf, 0xe3, 0x8b, 0x81, 0xaf, 0x5d, 0x02, 0xa6, 0x9a, 0x99,
+	0x73, 0xa7, 0xe5, 0x33, 0x54, 0x3e, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x70, 0xfe,
+	0x07, 0x00, 0x08, 0x4a, 0x9f, 0xde, 0x72, 0xe7, 0xb4, 0x7d, 0x4e, 0x03, 0xa6, 0x9a, 0x99, 0x73,
+	0xa7, 0xe5, 0x33, 0x54, 0x3e, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xfa, 0x1f,
+	0x00, 0x00, 0x4a, 0x9f, 0x25, 0xe2, 0xae, 0x6c, 0xe9, 0x69, 0x00, 0xa6, 0x9a, 0x99, 0x73, 0xa7,
+	0xe5, 0x33, 0x54, 0x3d, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac, 0xfe, 0xfd, 0xbf,
+	0x7d, 0x05, 0x00, 0x54, 0x5b, 0x8f, 0x25, 0xf0, 0x8f, 0xc7, 0x2d, 0x01, 0xa6, 0x9a, 0x99, 0x73,
+	0xa7, 0xe6, 0x33, 0x14, 0x3b, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac, 0xfe, 0xef,
+	0xaf, 0x15, 0x00, 0x04, 0xa5, 0x59, 0x8e, 0x59, 0xa7, 0xe6, 0x04, 0xa6, 0x9a, 0x99, 0x73, 0xa7,
+	0xe6, 0x33, 0x14, 0x3b, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac, 0xfe, 0xef, 0x67,
+	0x05, 0x41, 0x11, 0x94, 0x66, 0xd9, 0xea, 0x17, 0xcd, 0x29, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5,
+	0x33, 0x54, 0x3d, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac, 0xfe, 0xfd, 0xdf, 0xae,
+	0x00, 0x80, 0x68, 0xdb, 0xb1, 0x74, 0x7a, 0xe0, 0xb8, 0xa5, 0x00, 0xa6, 0x9a, 0x99, 0x73, 0xa7,
+	0xe5, 0x33, 0x54, 0x3d, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xfa, 0x1f, 0x01,
+	0xa0, 0x08, 0xbd, 0x37, 0xe8, 0x0a, 0x53, 0xad, 0x3f, 0x1d, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5,
+	0x33, 0x54, 0x3e, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x70, 0xfe, 0x27, 0x00, 0x28,
+	0x42, 0xef, 0x36, 0x9d, 0x7c, 0xad, 0xd6, 0xd3, 0x01, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5, 0x33,
+	0x54, 0x3d, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac, 0xfe, 0xf6, 0x3f, 0xac, 0x00,
+	0x80, 0x48, 0xdb, 0xb3, 0x9c, 0x1f, 0xf2, 0x99, 0xf5, 0x00, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5,
+	0x33, 0x54, 0x3d, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac, 0xfe, 0xc7, 0x9f, 0x59,
+	0x01, 0x40, 0x11, 0x6d, 0x8e, 0x47, 0xbe, 0x6b, 0xb6, 0x0d, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe6,
+	0x33, 0x14, 0x3b, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac, 0xfe, 0x9f, 0x75, 0x05,
+	0x45, 0x50, 0x84, 0xdc, 0x69, 0xb0, 0x75, 0x6e, 0x00, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5, 0x33,
+	0x54, 0x3d, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac, 0xfe, 0xc7, 0xbf, 0x59, 0x01,
+	0x40, 0x11, 0x59, 0x98, 0x83, 0xf7, 0xea, 0x42, 0x7d, 0x00, 0xa6, 0x9a, 0x99, 0x73, 0x37, 0xcb,
+	0x67, 0xa8, 0x7a, 0x86, 0x22, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0xeb, 0xff, 0x0a, 0x00,
+	0xa0, 0xf4, 0xb9, 0x9c, 0xd5, 0x8e, 0xbe, 0x62, 0x03, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5, 0x33,
+	0x54, 0x3e, 0x43, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0xbf, 0x1f, 0x00, 0x82, 0xd2,
+	0x07, 0x39, 0xed, 0x42, 0x4e, 0x03, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5, 0x33, 0x54, 0x3d, 0x43,
+	0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x37, 0xff, 0x03, 0x00, 0x40, 0xe9, 0xf3, 0x05,
+	0x39, 0xf5, 0xa3, 0x3e, 0xbf, 0x01, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5, 0x33, 0x54, 0x3d, 0x43,
+	0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac, 0xfe, 0x87, 0x5f, 0x2b, 0x00, 0x08, 0x2a, 0xc3,
+	0xe1, 0x60, 0xc5, 0xe1, 0xfb, 0x00, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe6, 0x33, 0x14, 0x3b, 0x43,
+	0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac, 0xfe, 0xef, 0x56, 0x10, 0x14, 0x41, 0xc9, 0x8d,
+	0xac, 0x92, 0x3b, 0x00, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5, 0x33, 0x54, 0x3d, 0x43, 0x11, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0xac, 0xfe, 0x87, 0xdf, 0x2b, 0x00, 0x08, 0xaa, 0xc3, 0x51, 0x51,
+	0xa2, 0xe1, 0x7b, 0x03, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5, 0x33, 0x54, 0x3d, 0x43, 0x11, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0xac, 0xfe, 0xe6, 0x3f, 0xac, 0x00, 0x80, 0x68, 0xef, 0x2f, 0xb5,
+	0xf7, 0xe7, 0x7e, 0xb5, 0x1e, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5, 0x33, 0x54, 0x3e, 0x43, 0x11,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xb0, 0xfe, 0x4f, 0x00, 0x50, 0x84, 0xde, 0xa2, 0x5f, 0x5e,
+	0xa0, 0xa7, 0x03, 0xa6, 0x9a, 0x99, 0x73, 0x37, 0xcb, 0x67, 0xa8, 0x7a, 0x86, 0x22, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xe0, 0xeb, 0xff, 0x12, 0x00, 0x20, 0xf4, 0xbe, 0x9c, 0xb7, 0x8f, 0x39,
+	0x6c, 0x3d, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe5, 0x33, 0x54, 0x3d, 0x43, 0x11, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0xac, 0xfe, 0xc7, 0xbf, 0x5d, 0x01, 0x40, 0x11, 0xdd, 0x86, 0x47, 0x4b, 0xdf,
+	0xba, 0x37, 0xa6, 0x9a, 0x99, 0x73, 0xa7, 0xe6, 0x33, 0x14, 0x3b, 0x43, 0x11, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0xac, 0xfe, 0x9f, 0xb3, 0x82, 0x22, 0x28, 0x42, 0xee, 0x34, 0x08, 0x2e, 0x37,
+	0x00, 0xa2, 0x9a, 0x99, 0x59, 0xb1, 0x7c, 0x86, 0xca, 0x4a, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x80, 0xe1, 0xbf, 0x78, 0x74, 0xe0, 0xbf, 0x77, 0xef, 0x6a, 0xd5, 0xde, 0xbd, 0xab, 0xd7,
+	0xbb, 0x5a, 0xbf, 0xd8, 0x59, 0xc9, 0xcd, 0x02, 0x8a, 0x4d, 0xad, 0x36, 0xf1, 0x7e, 0x8b, 0x55,
+	0x1d, 0xa5, 0x8b, 0x02, 0x01, 0x00, 0x08, 0x00, 0x80, 0x05, 0x40, 0xf7, 0xfe, 0xf1, 0x5f, 0xfc,
+	0x8b, 0xef, 0x1d, 0x00, 0x6b, 0xfd, 0xff, 0xfd, 0xd7, 0x86, 0xf5, 0x4b, 0x96, 0x6e, 0xb8, 0xfc,
+	0xb4, 0xcb, 0x57, 0x9f, 0xbe, 0xa6, 0xef, 0xb0, 0xfa, 0x28, 0x56, 0x5f, 0x1f, 0x80, 0x24, 0xcd,
+	0x1d, 0x3e, 0x7c, 0xf8, 0xf0, 0xe1, 0xcc, 0xcc, 0xbc, 0xee, 0x77
+};